@@ -1,6 +1,12 @@
 #pragma once
 
+#include <chit/Instruction.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <span>
 #include <sstream>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -13,11 +19,20 @@ namespace chit {
 		struct Function final {
 			bool HasReturn;
 			std::vector<std::u8string_view> Parameters;
+			std::size_t FrameSize = 0;
 			BodyStream Body;
+			std::unordered_map<std::u8string_view, std::vector<std::u8string_view>> SourceNames;	// Source variables held by each local
+
+			// Optimized functions stay parsed until the linker writes them out
+			std::u8string Code;
+			std::vector<Instruction> Instructions;
+			bool IsOptimized = false;
 		};
 
 	private:
 		std::unordered_map<std::u8string_view, Function> m_Functions;
+		std::deque<std::u8string> m_LocalIdentifiers;
+		std::deque<std::u8string> m_Labels;
 
 	public:
 		Assembly() noexcept = default;
@@ -32,7 +47,22 @@ namespace chit {
 			std::u8string_view name,
 			bool hasReturn,
 			std::vector<std::u8string_view> parameters);
+		void SetFrameSize(std::u8string_view name, std::size_t frameSize) noexcept;
+		std::size_t GetFrameSize(std::u8string_view name) const noexcept;
+		std::u8string_view GetLocalIdentifier(std::size_t slot);
+		void AddSourceName(std::u8string_view name, std::size_t slot, std::u8string_view sourceName);
+		std::span<const std::u8string_view> GetSourceNames(std::u8string_view name, std::u8string_view local) const noexcept;
 
+		void Optimize();
 		std::u8string Generate() const;
+		std::vector<std::u8string_view> GetFunctionNames() const;
+		bool HasReturn(std::u8string_view name) const noexcept;
+		std::span<const std::u8string_view> GetParameters(std::u8string_view name) const noexcept;
+		std::span<const Instruction> GetInstructions(std::u8string_view name) const noexcept;
+		std::u8string GenerateFunction(std::u8string_view name) const;
+		std::u8string GenerateFunction(
+			std::u8string_view name,
+			std::span<const std::u8string_view> parameters,
+			std::span<const Instruction> instructions) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chit/Effect.hpp>
+#include <chit/Generator.hpp>
+#include <chit/Lexer.hpp>
+#include <chit/LineMap.hpp>
+#include <chit/Linker.hpp>
+#include <chit/Message.hpp>
+#include <chit/Parser.hpp>
+#include <chit/Profile.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chit {
+	class Compiler final {
+	private:
+		struct Unit final {
+			chit::Lexer Lexer;
+			chit::Parser Parser;
+			std::optional<chit::Generator> Generator;
+
+			std::vector<Message> Messages;
+
+			explicit Unit(std::u8string source);
+		};
+
+	private:
+		std::vector<std::unique_ptr<Unit>> m_Units;
+		std::unique_ptr<Profile> m_Profile;
+		EffectTable m_Effects;
+		Linker m_Linker;
+		bool m_IsLinkTimeOptimizing = false;
+
+	public:
+		Compiler() noexcept = default;
+		Compiler(Compiler&& other) noexcept = default;
+		~Compiler() = default;
+
+	public:
+		Compiler& operator=(Compiler&& other) noexcept = default;
+
+	public:
+		std::size_t AddSource(std::u8string source);
+		void SetProfile(Profile profile);
+		void SetMinifying(bool isMinifying) noexcept;
+		void SetLinkTimeOptimizing(bool isLinkTimeOptimizing) noexcept;
+
+		bool Compile();
+		std::u8string_view GetShitBF() const noexcept;
+		std::u8string_view GetNameMap() const noexcept;
+		std::u8string_view GetFrameSizes() const noexcept;
+		std::size_t GetUnitCount() const noexcept;
+		std::span<const Message> GetMessages(std::size_t unit) const noexcept;
+		const LineMap& GetLineMap(std::size_t unit) const noexcept;
+	};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chit/Token.hpp>
+#include <chit/Type.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace chit {
+	class GeneratorContext;
+
+	class Constant final {
+	public:
+		std::shared_ptr<BuiltinType> Type;
+		std::uint64_t Value = 0;			// Bits of the value, extended to 64 bits as its type would be
+
+	public:
+		Constant(std::shared_ptr<BuiltinType> type, std::uint64_t value) noexcept;
+		Constant(const Constant&) = default;
+		~Constant() = default;
+
+	public:
+		Constant& operator=(const Constant&) = default;
+		bool operator==(const Constant& other) const noexcept;
+
+	public:
+		std::int64_t GetSigned() const noexcept;
+		bool IsZero() const noexcept;
+
+		Constant Convert(const TypePtr& type) const noexcept;
+		void Generate(GeneratorContext& context) const;
+
+	public:
+		static std::optional<Constant> Evaluate(
+			TokenType operator_,
+			const Constant& left,
+			const Constant& right,
+			const TypePtr& resultType);
+	};
+}
\ No newline at end of file
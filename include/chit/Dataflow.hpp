@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chit/Instruction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace chit {
+	class BitVector final {
+	private:
+		std::vector<std::uint64_t> m_Words;
+		std::size_t m_Size = 0;
+
+	public:
+		BitVector() noexcept = default;
+		explicit BitVector(std::size_t size, bool value = false);
+		BitVector(const BitVector& other) = default;
+		BitVector(BitVector&& other) noexcept = default;
+		~BitVector() = default;
+
+	public:
+		BitVector& operator=(const BitVector& other) = default;
+		BitVector& operator=(BitVector&& other) noexcept = default;
+		bool operator==(const BitVector& other) const noexcept = default;
+
+		BitVector& operator|=(const BitVector& other) noexcept;
+		BitVector& operator&=(const BitVector& other) noexcept;
+
+	public:
+		std::size_t GetSize() const noexcept;
+		void Resize(std::size_t size, bool value = false);
+
+		bool Test(std::size_t index) const noexcept;
+		void Set(std::size_t index) noexcept;
+		void Reset(std::size_t index) noexcept;
+		void Subtract(const BitVector& other) noexcept;
+
+	private:
+		void ClearPadding() noexcept;
+	};
+}
+
+namespace chit {
+	struct BasicBlock final {
+		std::size_t Begin = 0;
+		std::size_t End = 0;
+
+		std::vector<std::size_t> Successors;
+		std::vector<std::size_t> Predecessors;
+	};
+
+	std::vector<BasicBlock> FindBasicBlocks(const std::vector<Instruction>& instructions);
+}
+
+namespace chit {
+	enum class DataflowDirection {
+		Forward,
+		Backward,
+	};
+
+	enum class DataflowMeet {
+		Union,
+		Intersection,
+	};
+
+	struct DataflowProblem final {
+		DataflowDirection Direction = DataflowDirection::Forward;
+		DataflowMeet Meet = DataflowMeet::Union;
+		std::size_t Size = 0;
+
+		std::vector<BitVector> Gen;
+		std::vector<BitVector> Kill;
+		BitVector Boundary;			// Entering the first block, or leaving blocks without successors
+	};
+
+	struct DataflowResult final {
+		std::vector<BitVector> In;
+		std::vector<BitVector> Out;
+	};
+
+	DataflowResult SolveDataflow(const std::vector<BasicBlock>& blocks, const DataflowProblem& problem);
+}
+
+namespace chit {
+	struct VariableSymbol;
+
+	class DefiniteAssignment final {
+	public:
+		struct State final {
+			BitVector Assigned;			// On every path
+			BitVector MaybeAssigned;	// On some path
+			bool IsReachable = true;
+		};
+
+	private:
+		std::unordered_map<VariableSymbol*, std::size_t> m_Indices;
+		std::vector<VariableSymbol*> m_Variables;
+		BitVector m_IsWeakened;			// Whether a read has already lowered the state of the variable
+
+		State m_State;
+
+	public:
+		DefiniteAssignment() = default;
+		DefiniteAssignment(const DefiniteAssignment&) = delete;
+		~DefiniteAssignment() = default;
+
+	public:
+		DefiniteAssignment& operator=(const DefiniteAssignment&) = delete;
+
+	public:
+		void Declare(VariableSymbol* symbol, bool isAssigned);
+		void Assign(VariableSymbol* symbol);
+		void Read(VariableSymbol* symbol);
+		void Terminate() noexcept;
+		bool IsWeakened(VariableSymbol* symbol) const;
+
+		State Save() const;
+		void Restore(State state);
+		void Merge(State state);
+
+	private:
+		void Grow(State& state) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace chit {
+	struct DriverOptions final {
+		std::vector<std::string> InputPaths;
+		std::string OutputPath;
+		std::string ProfilePath;
+		std::string NameMapPath;
+		std::string FrameSizesPath;
+		bool IsMinifying = false;
+		bool IsLinkTimeOptimizing = false;
+	};
+
+	struct DriverResult final {
+		int ExitCode = 0;
+		std::string Output;		// Written to the standard output
+		std::string Errors;		// Written to the standard error
+		std::vector<std::pair<std::string, std::string>> Files;
+	};
+
+	using FileReader = std::function<std::optional<std::string>(const std::string& path)>;
+
+	std::optional<DriverOptions> ParseArguments(const std::vector<std::string>& arguments);
+	std::vector<std::string> GetReadPaths(const DriverOptions& options);
+
+	// Files are read and written through the caller, so the same run can serve a local build or a remote client
+	DriverResult RunDriver(const DriverOptions& options, const FileReader& readFile);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace chit {
+	struct Effect final {
+		bool ReadsGlobals = false;
+		bool WritesGlobals = false;
+		bool MayNotTerminate = false;
+		bool MayTrap = false;			// Divides by a value not known to be nonzero
+
+		bool IsPure() const noexcept;
+		bool HasSideEffect() const noexcept;
+
+		Effect& operator|=(const Effect& other) noexcept;
+
+		static Effect GetUnknown() noexcept;
+	};
+}
+
+namespace chit {
+	class RootNode;
+
+	class EffectTable final {
+	private:
+		std::unordered_map<std::u8string, Effect> m_Effects;
+
+	public:
+		EffectTable() noexcept = default;
+		EffectTable(EffectTable&& other) noexcept = default;
+		~EffectTable() = default;
+
+	public:
+		EffectTable& operator=(EffectTable&& other) noexcept = default;
+
+	public:
+		void Summarize(std::span<const RootNode* const> roots);
+		std::optional<Effect> Find(std::u8string_view function) const;
+	};
+}
\ No newline at end of file
@@ -1,32 +1,116 @@
 #pragma once
 
 #include <chit/Assembly.hpp>
+#include <chit/Constant.hpp>
+#include <chit/Interpreter.hpp>
+#include <chit/Range.hpp>
 #include <chit/Message.hpp>
+#include <chit/Profile.hpp>
+#include <chit/Symbol.hpp>
+#include <chit/Type.hpp>
 #include <chit/ast/Node.hpp>
 
+#include <cstddef>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+namespace chit {
+	class Frame final {
+	private:
+		struct Slot final {
+			std::size_t Size;
+			bool IsUsed;
+		};
+
+	private:
+		std::vector<Slot> m_Slots;
+
+	public:
+		Frame() noexcept = default;
+		Frame(const Frame&) = delete;
+		~Frame() = default;
+
+	public:
+		Frame& operator=(const Frame&) = delete;
+
+	public:
+		std::size_t AllocateSlot(const TypePtr& type);
+		void FreeSlot(std::size_t slot) noexcept;
+		std::size_t GetSize() const noexcept;
+	};
+}
+
+namespace chit {
+	class FunctionDefinitionNode;
+
+	struct FunctionContext final {
+		const FunctionDefinitionNode* Definition;
+		std::u8string_view Name;
+		std::u8string_view EntryLabel;
+		std::span<const std::optional<Constant>> Arguments;	// Constant arguments of a specialization, empty for the general body
+		bool IsEntryLabelUsed = false;
+		bool IsMeasuring = false;							// Code generated only to measure its size has no effect outside
+		BodyStream ColdBlocks;
+	};
+}
+
+namespace chit {
+	struct FlowState final {
+		std::unordered_map<const VariableSymbol*, Constant> Values;						// Variables assigned after their declaration, whose value is known here
+		std::vector<std::pair<const ExpressionNode*, const VariableSymbol*>> Expressions;	// Initializers whose value is still held by their variable
+		bool IsReachable = true;
+
+		void Merge(FlowState other);
+	};
+}
+
 namespace chit {
 	class GeneratorContext final {
 	public:
 		GeneratorContext* const Parent = nullptr;
 
 		chit::Assembly& Assembly;
+		const chit::Profile* const Profile = nullptr;
 		BodyStream* const Stream = nullptr;
+		chit::Frame* const Frame = nullptr;
+		FunctionContext* const Function = nullptr;
+		const FunctionDefinitionNode* const InlinedFunction = nullptr;
+		chit::Interpreter* const Interpreter = nullptr;
 		std::vector<Message>& Messages;
 
 		std::unordered_set<std::u8string> TempIdentifiers;
+		std::size_t NextTempIdentifier = 0;
+		std::unordered_map<const VariableSymbol*, std::size_t> Locals;
+		std::unordered_map<const VariableSymbol*, std::size_t> Aliases;	// Variables sharing the slot of an earlier one with the same value
+		std::unordered_map<const VariableSymbol*, Constant> Constants;
+		std::unordered_map<const VariableSymbol*, Range> Ranges;
+		std::vector<std::pair<const FunctionCallNode*, std::size_t>> PureCalls;
+		FlowState Flow;													// Only used by the outermost context of a function
 
 	public:
 		std::u8string_view CreateTempIdentifier();
 		void DeleteTempIdentifier(std::u8string_view identifier);
 
+		std::size_t CreateLocal(const VariableSymbol* symbol, const TypePtr& type);
+		std::optional<std::size_t> FindLocal(const VariableSymbol* symbol) const;
+		void DeleteLocals() noexcept;
+		std::optional<Constant> FindConstant(const VariableSymbol* symbol) const;
+		bool AssignConstant(const VariableSymbol* symbol, const Constant& value);
+		std::optional<Range> FindRange(const VariableSymbol* symbol) const;
+		std::optional<std::size_t> FindPureCall(const FunctionCallNode* call) const;
+
+		FlowState& GetFlow() noexcept;
+		void AssignValue(const VariableSymbol* symbol, std::optional<Constant> value);
+		std::optional<std::size_t> FindExpression(const ExpressionNode& expression, const TypePtr& type) const;
+
+		bool IsGenerating(const FunctionDefinitionNode* definition) const noexcept;
+
 	private:
 		bool HasTempIdentifier(const std::u8string& identifier);
 	};
@@ -36,12 +120,13 @@ namespace chit {
 	class Generator final {
 	private:
 		const RootNode* m_RootNode;
+		const Profile* m_Profile;
 
 		std::optional<Assembly> m_Assembly;
 		std::vector<Message> m_Messages;
 
 	public:
-		explicit Generator(const RootNode* rootNode) noexcept;
+		explicit Generator(const RootNode* rootNode, const Profile* profile = nullptr) noexcept;
 		Generator(Generator&& other) noexcept = default;
 		~Generator() = default;
 
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chit {
+	struct Instruction final {
+		std::u8string_view Mnemonic;		// Empty if the instruction is a label
+		std::u8string_view Operand;
+
+		bool IsLabel() const noexcept;
+		bool IsJump() const noexcept;
+		bool IsTerminator() const noexcept;
+		bool Is(std::u8string_view mnemonic) const noexcept;
+		bool Is(std::u8string_view mnemonic, std::u8string_view operand) const noexcept;
+	};
+
+	std::vector<Instruction> ParseInstructions(std::u8string_view code);
+	std::u8string WriteInstructions(std::span<const Instruction> instructions);
+}
\ No newline at end of file
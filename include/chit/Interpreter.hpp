@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chit/Assembly.hpp>
+#include <chit/Constant.hpp>
+#include <chit/Message.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace chit {
+	struct Completion final {
+		bool IsReturn = false;
+		std::optional<Constant> Value;
+	};
+}
+
+namespace chit {
+	class FunctionDefinitionNode;
+
+	class Interpreter final {
+	private:
+		Assembly m_Assembly;
+		std::vector<Message> m_Messages;
+
+		std::size_t m_Steps = 0;
+		std::size_t m_Depth = 0;
+
+	public:
+		static constexpr std::size_t MaxSteps = 10000;
+		static constexpr std::size_t MaxDepth = 64;
+
+	public:
+		Interpreter() noexcept = default;
+		Interpreter(const Interpreter&) = delete;
+		~Interpreter() = default;
+
+	public:
+		Interpreter& operator=(const Interpreter&) = delete;
+
+	public:
+		std::optional<Constant> Call(const FunctionDefinitionNode* definition, std::span<const Constant> arguments);
+		bool Step() noexcept;
+	};
+}
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <chit/LineMap.hpp>
 #include <chit/Message.hpp>
 #include <chit/Token.hpp>
 
 #include <cstddef>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
@@ -13,20 +15,19 @@ namespace chit {
 	private:
 		struct Cursor final {
 			std::u8string::iterator Iterator;
-			std::size_t Column;
 			char32_t Codepoint;
 		};
 
 	private:
 		std::u8string m_Source;
 		std::u8string::iterator m_Current;
-		std::size_t m_Line = 1, m_Column = 0;
+		LineMap m_LineMap;
 
 		std::vector<Token> m_Tokens;
 		std::vector<Message> m_Messages;
 
 	public:
-		explicit Lexer(std::u8string source) noexcept;
+		explicit Lexer(std::u8string source);
 		Lexer(Lexer&& other) noexcept = default;
 		~Lexer() = default;
 
@@ -35,15 +36,18 @@ namespace chit {
 
 	public:
 		void Lex();
+		Token NextToken();
 		std::span<const Token> GetTokens() const noexcept;
 		std::span<const Message> GetMessages() const noexcept;
+		const LineMap& GetLineMap() const noexcept;
 
 	private:
 		Cursor NextCursor();
 		void PrevCursor();
+		std::size_t GetOffset(const Cursor& cursor) const noexcept;
 
-		void LexNumber(const Cursor& begin);
-		void LexSpeicalSymbol(const Cursor& begin);
-		void LexIdentifier(const Cursor& begin);
+		Token LexNumber(const Cursor& begin);
+		std::optional<Token> LexSpeicalSymbol(const Cursor& begin);
+		Token LexIdentifier(const Cursor& begin);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace chit {
+	struct Location final {
+		std::size_t Line, Column;
+	};
+
+	class LineMap final {
+	private:
+		std::u8string_view m_Source;
+		std::vector<std::size_t> m_LineOffsets;
+
+	public:
+		LineMap() noexcept = default;
+		explicit LineMap(std::u8string_view source);
+		LineMap(LineMap&& other) noexcept = default;
+		~LineMap() = default;
+
+	public:
+		LineMap& operator=(LineMap&& other) noexcept = default;
+
+	public:
+		Location GetLocation(std::size_t offset) const noexcept;
+	};
+}
@@ -2,7 +2,9 @@
 
 #include <chit/Assembly.hpp>
 #include <chit/Message.hpp>
+#include <chit/Profile.hpp>
 
+#include <deque>
 #include <span>
 #include <string>
 #include <string_view>
@@ -12,8 +14,14 @@ namespace chit {
 	class Linker final {
 	private:
 		std::vector<const Assembly*> m_Assemblies;
+		const Profile* m_Profile = nullptr;
+		bool m_IsMinifying = false;
+		bool m_IsLinkTimeOptimizing = false;
 
 		std::u8string m_ShitBF;
+		std::u8string m_NameMap;
+		std::u8string m_FrameSizes;
+		std::deque<std::u8string> m_ShortNames;
 		std::vector<Message> m_Messages;
 
 	public:
@@ -26,9 +34,14 @@ namespace chit {
 
 	public:
 		void AddAssembly(const Assembly* assembly) noexcept;
+		void SetProfile(const Profile* profile) noexcept;
+		void SetMinifying(bool isMinifying) noexcept;
+		void SetLinkTimeOptimizing(bool isLinkTimeOptimizing) noexcept;
 
 		void Link() noexcept;
 		std::u8string_view GetShitBF() const noexcept;
+		std::u8string_view GetNameMap() const noexcept;
+		std::u8string_view GetFrameSizes() const noexcept;
 		std::span<const Message> GetMessages() const noexcept;
 	};
 }
\ No newline at end of file
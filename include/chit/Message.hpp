@@ -7,11 +7,12 @@
 namespace chit {
 	enum class MessageType {
 		Error,
+		Warning,
 	};
 
 	struct Message final {
 		MessageType Type;
 		std::u8string Data;
-		std::size_t Line, Column;
+		std::size_t Offset;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <chit/Instruction.hpp>
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace chit {
+	using LabelCreator = std::function<std::u8string_view()>;
+
+	void SimplifyControlFlow(std::vector<Instruction>& instructions, const LabelCreator& createLabel);
+	void ScheduleStack(std::vector<Instruction>& instructions);
+}
\ No newline at end of file
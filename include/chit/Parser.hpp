@@ -1,29 +1,42 @@
 #pragma once
 
+#include <chit/Lexer.hpp>
 #include <chit/Message.hpp>
 #include <chit/Symbol.hpp>
 #include <chit/Token.hpp>
 #include <chit/Type.hpp>
 #include <chit/ast/Node.hpp>
 
+#include <array>
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
 namespace chit {
+	class FunctionDefinitionNode;
+
 	struct ParserContext final {
 		std::vector<Message>& Messages;
 
 		chit::SymbolTable SymbolTable;
 		TypePtr FunctionReturnType;
+		const FunctionDefinitionNode* Function = nullptr;
 	};
 }
 
 namespace chit {
 	class Parser final {
+	public:
+		static constexpr std::size_t TokenBufferSize = 2;	// Current token and previous token
+
 	private:
 		std::span<const Token> m_Tokens;
-		std::span<const Token>::iterator m_Current;
+		Lexer* m_Lexer = nullptr;
+		std::array<Token, TokenBufferSize> m_TokenBuffer{};
+		std::size_t m_LexedTokenCount = 0;
+		std::size_t m_Current = 0;
 
 		std::unique_ptr<ParserContext> m_RootContext;
 		std::unique_ptr<RootNode> m_RootNode;
@@ -31,6 +44,7 @@ namespace chit {
 
 	public:
 		explicit Parser(std::span<const Token> tokens) noexcept;
+		explicit Parser(Lexer& lexer) noexcept;
 		Parser(Parser&& other) noexcept = default;
 		~Parser() = default;
 
@@ -43,8 +57,10 @@ namespace chit {
 		std::span<const Message> GetMessages() const noexcept;
 
 	private:
-		const Token* AcceptToken(TokenType tokenType) noexcept;
-		const Token& PrevToken() const noexcept;
+		const Token& GetToken(std::size_t index);
+		const Token& CurrentToken();
+		const Token& PrevToken();
+		std::optional<Token> AcceptToken(TokenType tokenType);
 
 		std::unique_ptr<TypeNode> ParseType();
 
@@ -64,9 +80,9 @@ namespace chit {
 		std::unique_ptr<ExpressionNode> ParseSimpleExpression();
 
 		std::unique_ptr<ExpressionNode> ParseInteger(
-			const Token* integerToken);
+			const Token& integerToken);
 		bool ParseIntegerSuffix(
-			const Token* integerToken,
+			const Token& integerToken,
 			bool& isUnsigned, bool& isLong, bool& isLongLong);
 
 		std::unique_ptr<StatementNode> ParseStatement();
@@ -74,10 +90,10 @@ namespace chit {
 		std::unique_ptr<StatementNode> ParseIf();
 		std::unique_ptr<StatementNode> ParseFunctionDeclaration(
 			std::unique_ptr<TypeNode> returnTypeNode,
-			const Token* nameToken);
+			const Token& nameToken);
 		std::unique_ptr<StatementNode> ParseVariableDeclaration(
 			std::unique_ptr<TypeNode> typeNode,
-			const Token* nameToken);
+			const Token& nameToken);
 
 		std::unique_ptr<BlockNode> ParseBlock();
 		std::unique_ptr<StatementNode> ParseStatementOrBlock();
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace chit {
+	struct BranchCount final {
+		std::uint64_t Then, Else;
+	};
+
+	class Profile final {
+	private:
+		struct Function final {
+			std::optional<std::uint64_t> CallCount;
+			std::unordered_map<std::size_t, BranchCount> Branches;	// Keyed by index, since a profile may name any index
+		};
+
+	private:
+		std::unordered_map<std::u8string, Function> m_Functions;
+		std::uint64_t m_MaxCallCount = 0;
+
+	public:
+		static constexpr std::uint64_t HotRatio = 10;	// Hot functions are called at least 1/HotRatio as often as the hottest one
+
+	public:
+		Profile() noexcept = default;
+		Profile(Profile&& other) noexcept = default;
+		~Profile() = default;
+
+	public:
+		Profile& operator=(Profile&& other) noexcept = default;
+
+	public:
+		bool Parse(std::u8string_view text);
+
+		std::optional<std::uint64_t> GetCallCount(std::u8string_view function) const;
+		std::optional<BranchCount> GetBranchCount(std::u8string_view function, std::size_t branch) const;
+		bool IsHot(std::u8string_view function) const;
+	};
+}
\ No newline at end of file
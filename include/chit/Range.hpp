@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chit/Token.hpp>
+#include <chit/Type.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace chit {
+	struct Range final {
+		std::int64_t Min;
+		std::int64_t Max;
+
+		bool IsIn(const Range& other) const noexcept;
+		bool IsPoint() const noexcept;
+
+		static std::optional<Range> GetTypeRange(const TypePtr& type) noexcept;
+		static bool IsIn(const std::optional<Range>& range, const TypePtr& type) noexcept;
+		static std::optional<Range> Convert(const std::optional<Range>& range, const TypePtr& type) noexcept;
+		static std::optional<Range> Evaluate(TokenType operator_, const Range& left, const Range& right) noexcept;
+	};
+}
\ No newline at end of file
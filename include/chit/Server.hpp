@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chit/Driver.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace chit {
+	class Server final {
+	private:
+		std::string m_SocketPath;
+		std::vector<std::pair<std::string, std::string>> m_Results;	// Requests and their responses, oldest first
+
+	public:
+		static constexpr std::size_t MaxResultCount = 64;
+		static constexpr int TimeoutSeconds = 10;		// A client that stalls longer is dropped, so it cannot hold up later builds
+
+	public:
+		explicit Server(std::string socketPath);
+		Server(const Server&) = delete;
+		~Server() = default;
+
+	public:
+		Server& operator=(const Server&) = delete;
+
+	public:
+		bool Run();
+
+	private:
+		std::string Respond(const std::string& request);
+	};
+
+	// Returns nothing if no server is listening, so the caller can compile by itself
+	std::optional<DriverResult> RequestCompile(const std::string& socketPath, const std::vector<std::string>& arguments,
+		const std::vector<std::pair<std::string, std::string>>& files);
+}
\ No newline at end of file
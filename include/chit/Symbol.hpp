@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chit/Effect.hpp>
 #include <chit/Type.hpp>
 
 #include <memory>
@@ -18,14 +19,21 @@ namespace chit {
 	};
 
 	struct VariableSymbol final {
+		std::u8string_view Name;
 		TypePtr Type;
 		VariableState State = VariableState::Uninitialized;
+		bool IsModified = false;
+		bool IsGlobal = false;
 	};
 }
 
 namespace chit {
+	class FunctionDefinitionNode;
+
 	struct FunctionSymbol final {
 		std::shared_ptr<FunctionType> Type;
+		const FunctionDefinitionNode* Definition = nullptr;
+		std::optional<chit::Effect> Effect;
 	};
 }
 
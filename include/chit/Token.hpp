@@ -62,6 +62,6 @@ namespace chit {
 	struct Token final {
 		TokenType Type;
 		std::u8string_view Data, Suffix;
-		std::size_t Line, Column;
+		std::size_t Offset;
 	};
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <chit/util/Json.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string_view>
@@ -20,8 +21,10 @@ namespace chit {
 		Type& operator=(const Type&) = delete;
 
 	public:
-		virtual JsonValue DumpJson() const = 0;
-		virtual void GenerateConvert(GeneratorContext& context) const = 0;
+		virtual void DumpJson(JsonWriter& writer) const = 0;
+		virtual void GenerateConvert(
+			GeneratorContext& context,
+			const std::shared_ptr<Type>& from) const = 0;
 
 		virtual bool IsEqual(const std::shared_ptr<Type>& other) const noexcept;
 		virtual bool IsVoid() const noexcept;
@@ -44,17 +47,21 @@ namespace chit {
 	public:
 		std::u8string_view Name;
 		std::optional<int> Rank;
+		std::size_t Size = 0;				// Size of the ShitVM representation in bytes
 
 	public:
 		explicit BuiltinType(std::u8string_view name) noexcept;
-		BuiltinType(std::u8string_view name, int rank) noexcept;
+		BuiltinType(std::u8string_view name, int rank, std::size_t size) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
-		virtual void GenerateConvert(GeneratorContext& context) const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
+		virtual void GenerateConvert(
+			GeneratorContext& context,
+			const TypePtr& from) const override;
 
 		virtual bool IsVoid() const noexcept override;
 		bool IsUnsigned() const noexcept;
+		std::shared_ptr<BuiltinType> GetUnsignedType() const noexcept;
 
 	public:
 		static TypePtr RunUsualArithmeticConversion(
@@ -78,8 +85,10 @@ namespace chit {
 			std::vector<TypePtr> parameterTypes) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
-		virtual void GenerateConvert(GeneratorContext& context) const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
+		virtual void GenerateConvert(
+			GeneratorContext& context,
+			const TypePtr& from) const override;
 
 		virtual bool IsEqual(const TypePtr& other) const noexcept override;
 	};
@@ -1,19 +1,28 @@
 #pragma once
 
+#include <chit/Dataflow.hpp>
 #include <chit/Symbol.hpp>
 #include <chit/ast/Node.hpp>
 #include <chit/util/Json.hpp>
 
+#include <cstddef>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 namespace chit {
+	class VariableDeclarationNode;
+
 	class FunctionDeclarationNode final : public StatementNode {
 	public:
 		std::unique_ptr<TypeNode> ReturnType;
 		std::u8string_view Name;
+		std::size_t NameOffset;
 		std::vector<std::pair<
 			std::u8string_view,
 			std::unique_ptr<TypeNode>>> Parameters;
@@ -24,22 +33,45 @@ namespace chit {
 		FunctionDeclarationNode(
 			std::unique_ptr<TypeNode> returnType,
 			std::u8string_view name,
+			std::size_t nameOffset,
 			std::vector<std::pair<
 				std::u8string_view,
 				std::unique_ptr<TypeNode>>> parameters) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
 	};
 
 	class FunctionDefinitionNode final : public StatementNode {
+	private:
+		struct Specialization final {
+			std::vector<std::optional<Constant>> Arguments;
+			std::u8string Name;
+			bool IsAccepted;
+			bool IsGenerated = false;
+		};
+
 	public:
 		std::unique_ptr<FunctionDeclarationNode> Prototype;
 		std::unique_ptr<BlockNode> Body;
 
 		mutable std::unique_ptr<chit::ParserContext> ParserContext;
+		mutable std::optional<std::size_t> InlineCost;
+		mutable std::size_t BranchCount = 0;
+		mutable Effect LocalEffect;
+		mutable DefiniteAssignment Assignment;
+		mutable std::vector<const VariableDeclarationNode*> Variables;
+		mutable std::vector<std::u8string_view> Callees;
+		mutable std::vector<std::pair<std::vector<Constant>, std::optional<Constant>>> Evaluations;
+		mutable std::deque<Specialization> Specializations;
+		mutable std::optional<std::size_t> Cost;
+		mutable std::size_t SpecializedCost = 0;
+
+		static constexpr std::size_t InlineThreshold = 16;
+		static constexpr std::size_t HotInlineThreshold = 64;
+		static constexpr std::size_t SpecializationGrowth = 2;	// Clones of a function may add up to this many times its size
 
 	public:
 		FunctionDefinitionNode(
@@ -47,9 +79,31 @@ namespace chit {
 			std::unique_ptr<BlockNode> body) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(chit::ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+
+		bool CanInline(const GeneratorContext& context) const;
+		void GenerateInline(GeneratorContext& context, std::span<const std::optional<Constant>> arguments = {}) const;
+		std::optional<std::u8string_view> GetSpecialization(
+			const GeneratorContext& context,
+			const std::vector<std::optional<Constant>>& arguments) const;
+		bool GenerateSpecializations(GeneratorContext& context) const;
+		std::optional<Constant> Evaluate(
+			const GeneratorContext& context,
+			const std::vector<Constant>& arguments) const;
+
+		VariableSymbol* GetParameterSymbol(std::size_t index) const;
+
+	private:
+		void GenerateFunction(
+			GeneratorContext& context,
+			std::u8string_view name,
+			std::span<const std::optional<Constant>> arguments,
+			bool isMeasuring) const;
+		bool IsInlinable() const noexcept;
+		std::size_t GetInlineCost() const;
+		std::size_t GetCost(std::span<const std::optional<Constant>> arguments) const;
 	};
 }
 
@@ -58,6 +112,7 @@ namespace chit {
 	public:
 		std::unique_ptr<TypeNode> Type;
 		std::u8string_view Name;
+		std::size_t NameOffset;
 		std::unique_ptr<ExpressionNode> Initializer;
 
 		mutable VariableSymbol* Symbol = nullptr;
@@ -66,11 +121,13 @@ namespace chit {
 		VariableDeclarationNode(
 			std::unique_ptr<TypeNode> type,
 			std::u8string_view name,
+			std::size_t nameOffset,
 			std::unique_ptr<ExpressionNode> initializer = nullptr) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const override;
 	};
 }
\ No newline at end of file
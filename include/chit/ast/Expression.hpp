@@ -5,8 +5,12 @@
 #include <chit/ast/Node.hpp>
 #include <chit/util/Json.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
 namespace chit {
 	class IdentifierNode final : public ExpressionNode {
@@ -19,11 +23,16 @@ namespace chit {
 		explicit IdentifierNode(std::u8string_view name) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
 		virtual void GenerateAssignment(GeneratorContext& context) const override;
 		virtual void GenerateFunctionCall(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
+		virtual std::optional<Range> EvaluateRange(const GeneratorContext& context) const override;
+		virtual bool IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const override;
+
+		void Resolve(ParserContext& context) const;
 	};
 }
 
@@ -36,9 +45,10 @@ namespace chit {
 		explicit IntConstantNode(std::int32_t value) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
 	};
 
 	class UnsignedIntConstantNode final : public ExpressionNode {
@@ -49,9 +59,10 @@ namespace chit {
 		explicit UnsignedIntConstantNode(std::uint32_t value) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
 	};
 
 	class LongIntConstantNode final : public ExpressionNode {
@@ -62,9 +73,10 @@ namespace chit {
 		explicit LongIntConstantNode(std::int32_t value) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
 	};
 
 	class UnsignedLongIntConstantNode final : public ExpressionNode {
@@ -75,9 +87,10 @@ namespace chit {
 		explicit UnsignedLongIntConstantNode(std::uint32_t value) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
 	};
 
 	class LongLongIntConstantNode final : public ExpressionNode {
@@ -88,9 +101,10 @@ namespace chit {
 		explicit LongLongIntConstantNode(std::int64_t value) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
 	};
 
 	class UnsignedLongLongIntConstantNode final : public ExpressionNode {
@@ -101,14 +115,22 @@ namespace chit {
 		explicit UnsignedLongLongIntConstantNode(std::uint64_t value) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
 	};
 }
 
 namespace chit {
 	class BinaryOperatorNode final : public ExpressionNode {
+	private:
+		struct Operand final {
+			const ExpressionNode* Expression;
+			TypePtr NewType;
+			std::size_t StackNeed;
+		};
+
 	public:
 		TokenType Operator;
 		std::unique_ptr<ExpressionNode> Left;
@@ -117,6 +139,7 @@ namespace chit {
 		mutable TypePtr OperandType;
 		mutable TypePtr NewLeftType;
 		mutable TypePtr NewRightType;
+		mutable std::optional<std::size_t> StackNeed;
 
 	public:
 		explicit BinaryOperatorNode(
@@ -125,13 +148,33 @@ namespace chit {
 			std::unique_ptr<ExpressionNode> right) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual bool GenerateNarrowValue(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
+		virtual std::optional<Range> EvaluateRange(const GeneratorContext& context) const override;
+		virtual std::optional<bool> PredictCondition(const GeneratorContext& context) const override;
+		virtual std::size_t GetStackNeed() const noexcept override;
+		virtual bool HasSideEffect() const noexcept override;
+		virtual bool IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const override;
+		virtual void CollectPureCalls(std::vector<const FunctionCallNode*>& calls) const override;
+
+		bool MayTrap() const noexcept;
+
+	private:
+		bool IsAssociative() const noexcept;
+		bool IsRightFirst() const noexcept;
+		bool IsComparison() const noexcept;
+		TypePtr GetComputeType(const GeneratorContext& context) const;
+		void GenerateOperation(GeneratorContext& context, const TypePtr& computeType) const;
+		void CollectOperands(std::vector<Operand>& operands) const;
 	};
 }
 
 namespace chit {
+	class FunctionDeclarationNode;
+
 	class FunctionCallNode final : public ExpressionNode {
 	public:
 		std::unique_ptr<ExpressionNode> Function;
@@ -143,8 +186,27 @@ namespace chit {
 			std::vector<std::unique_ptr<ExpressionNode>> arguments) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void GenerateValue(GeneratorContext& context) const override;
+		virtual bool GenerateTailCall(GeneratorContext& context) const override;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const override;
+		virtual std::size_t GetStackNeed() const noexcept override;
+		virtual bool HasSideEffect() const noexcept override;
+		virtual bool IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const override;
+		virtual void CollectPureCalls(std::vector<const FunctionCallNode*>& calls) const override;
+
+	private:
+		std::optional<Effect> GetEffect() const noexcept;
+		const FunctionDefinitionNode* GetDefinition() const noexcept;
+		void GenerateArguments(
+			GeneratorContext& context,
+			std::span<const std::optional<Constant>> skipped = {}) const;
+		std::vector<std::optional<Constant>> EvaluateArguments(
+			const GeneratorContext& context,
+			const FunctionDefinitionNode* definition) const;
+		bool GenerateSpecializedCall(
+			GeneratorContext& context,
+			const FunctionDefinitionNode* definition) const;
 	};
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <chit/Constant.hpp>
+#include <chit/Interpreter.hpp>
+#include <chit/Range.hpp>
 #include <chit/Type.hpp>
 #include <chit/util/Json.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace chit {
@@ -19,7 +24,7 @@ namespace chit {
 		Node& operator=(const Node&) = delete;
 
 	public:
-		virtual JsonValue DumpJson() const = 0;
+		virtual void DumpJson(JsonWriter& writer) const = 0;
 		virtual void Analyze(ParserContext& context) const = 0;
 	};
 }
@@ -29,13 +34,14 @@ namespace chit {
 	public:
 		mutable TypePtr Type;
 
-	public:
-		virtual JsonValue DumpJson() const override;
+	protected:
+		void DumpJsonFields(JsonWriter& writer) const;
 	};
 }
 
 namespace chit {
 	class GeneratorContext;
+	class FunctionCallNode;
 
 	class ExpressionNode : public Node {
 	public:
@@ -43,10 +49,26 @@ namespace chit {
 		mutable bool IsLValue = false;
 
 	public:
-		virtual JsonValue DumpJson() const override;
 		virtual void GenerateValue(GeneratorContext& context) const = 0;
 		virtual void GenerateAssignment(GeneratorContext& context) const;
 		virtual void GenerateFunctionCall(GeneratorContext& context) const;
+		virtual bool GenerateTailCall(GeneratorContext& context) const;
+		virtual bool GenerateNarrowValue(GeneratorContext& context) const;
+		virtual std::optional<Constant> EvaluateConstant(const GeneratorContext& context) const;
+		virtual std::optional<Range> EvaluateRange(const GeneratorContext& context) const;
+		virtual std::optional<bool> PredictCondition(const GeneratorContext& context) const;
+		virtual std::size_t GetStackNeed() const noexcept;
+		virtual bool HasSideEffect() const noexcept;
+		virtual bool IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const;
+		virtual void CollectPureCalls(std::vector<const FunctionCallNode*>& calls) const;
+
+		void GenerateRValue(GeneratorContext& context, const TypePtr& type = nullptr) const;
+
+	protected:
+		void DumpJsonFields(JsonWriter& writer) const;
+
+	private:
+		bool GenerateSharedRValue(GeneratorContext& context, const TypePtr& type) const;
 	};
 }
 
@@ -56,6 +78,8 @@ namespace chit {
 	class StatementNode : public Node {
 	public:
 		virtual void Generate(GeneratorContext& context) const = 0;
+		virtual bool AlwaysReturns(const GeneratorContext& context) const;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const;
 	};
 
 	class RootNode final : public StatementNode {
@@ -63,7 +87,7 @@ namespace chit {
 		std::vector<std::unique_ptr<StatementNode>> Statements;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
 	};
@@ -78,8 +102,10 @@ namespace chit {
 		explicit BlockNode(std::vector<std::unique_ptr<StatementNode>> statements) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(chit::ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+		virtual bool AlwaysReturns(const GeneratorContext& context) const override;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const override;
 	};
 }
\ No newline at end of file
@@ -4,14 +4,18 @@
 #include <chit/ast/Node.hpp>
 #include <chit/util/Json.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <string_view>
 
 namespace chit {
 	class EmptyStatementNode final : public StatementNode {
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const override;
 	};
 }
 
@@ -24,9 +28,10 @@ namespace chit {
 		explicit ExpressionStatementNode(std::unique_ptr<ExpressionNode> expression) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const override;
 	};
 }
 
@@ -41,9 +46,11 @@ namespace chit {
 		explicit ReturnNode(std::unique_ptr<ExpressionNode> expression) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+		virtual bool AlwaysReturns(const GeneratorContext& context) const override;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const override;
 	};
 }
 
@@ -54,6 +61,8 @@ namespace chit {
 		std::unique_ptr<StatementNode> Body;
 		std::unique_ptr<StatementNode> ElseBody;
 
+		mutable std::size_t BranchIndex = 0;
+
 	public:
 		IfNode(
 			std::unique_ptr<ExpressionNode> condition,
@@ -61,8 +70,19 @@ namespace chit {
 			std::unique_ptr<StatementNode> elseBody) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 		virtual void Generate(GeneratorContext& context) const override;
+		virtual bool AlwaysReturns(const GeneratorContext& context) const override;
+		virtual std::optional<Completion> Execute(GeneratorContext& context) const override;
+
+	private:
+		std::optional<bool> PredictBody(const GeneratorContext& context) const;
+		void GenerateBranches(
+			GeneratorContext& context,
+			std::u8string_view jump,
+			const StatementNode* fallthrough,
+			const StatementNode* target,
+			bool isTargetCold) const;
 	};
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ namespace chit {
 			std::vector<std::u8string_view> names) noexcept;
 
 	public:
-		virtual JsonValue DumpJson() const override;
+		virtual void DumpJson(JsonWriter& writer) const override;
 		virtual void Analyze(ParserContext& context) const override;
 
 	private:
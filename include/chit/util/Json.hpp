@@ -1,85 +1,46 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <ostream>
-#include <string>
-#include <variant>
-#include <vector>
-#include <utility>
+#include <string_view>
 
 namespace chit {
-	class JsonArray;
-	class JsonObject;
-
-	using JsonValue = std::variant<
-		std::monostate,					// Null
-		std::u8string,					// String
-		std::int64_t,					// Signed integer
-		std::uint64_t,					// Unsigned integer
-		bool,							// Boolean
-		std::unique_ptr<JsonArray>,		// Array
-		std::unique_ptr<JsonObject>>;	// Object
-
-	JsonValue JsonNull() noexcept;
-
-	std::basic_ostream<char8_t>& operator<<(
-		std::basic_ostream<char8_t>& stream,
-		const JsonValue& value);
-}
-
-namespace chit {
-	class JsonArray final {
-		friend std::basic_ostream<char8_t>& operator<<(
-			std::basic_ostream<char8_t>& stream,
-			const JsonArray& array);
-
+	class JsonWriter final {
 	private:
-		std::vector<JsonValue> m_Elements;
+		std::basic_ostream<char8_t>& m_Stream;
+		bool m_IsPretty;
 
-	public:
-		JsonArray() noexcept = default;
-		explicit JsonArray(std::vector<JsonValue> elements) noexcept;
-		JsonArray(JsonArray&& other) noexcept = default;
-		~JsonArray() = default;
+		std::size_t m_Depth = 0;
+		bool m_IsFirst = true;
+		bool m_HasKey = false;
 
 	public:
-		JsonArray& operator=(JsonArray&& other) noexcept = default;
+		explicit JsonWriter(std::basic_ostream<char8_t>& stream, bool isPretty = false) noexcept;
+		JsonWriter(const JsonWriter&) = delete;
+		~JsonWriter() = default;
 
 	public:
-		JsonArray& AddElement(JsonValue value);
-		JsonValue Build();
-	};
-
-	std::basic_ostream<char8_t>& operator<<(
-		std::basic_ostream<char8_t>& stream,
-		const JsonArray& array);
-}
-
-namespace chit {
-	class JsonObject final {
-		friend std::basic_ostream<char8_t>& operator<<(
-			std::basic_ostream<char8_t>& stream,
-			const JsonObject& object);
-
-	private:
-		std::vector<std::pair<std::u8string, JsonValue>> m_Fields;
-
-	public:
-		JsonObject() noexcept = default;
-		JsonObject(JsonObject&& other) noexcept = default;
-		~JsonObject() = default;
+		JsonWriter& operator=(const JsonWriter&) = delete;
 
 	public:
-		JsonObject& operator=(JsonObject&& other) noexcept = default;
+		JsonWriter& BeginObject();
+		JsonWriter& EndObject();
+		JsonWriter& BeginArray();
+		JsonWriter& EndArray();
+		JsonWriter& Key(std::u8string_view name);
+
+		JsonWriter& Null();
+		JsonWriter& String(std::u8string_view value);
+		JsonWriter& Integer(std::int64_t value);
+		JsonWriter& Integer(std::uint64_t value);
+		JsonWriter& Boolean(bool value);
 
-	public:
-		JsonObject& SetField(std::u8string name, JsonValue value);
-		JsonObject& Merge(JsonValue&& object);
-		JsonValue Build();
+	private:
+		void BeginValue();
+		void BeginContainer(char8_t bracket);
+		void EndContainer(char8_t bracket);
+		void WriteIndent();
+		void WriteEscaped(std::u8string_view string);
 	};
-
-	std::basic_ostream<char8_t>& operator<<(
-		std::basic_ostream<char8_t>& stream,
-		const JsonObject& object);
-}
\ No newline at end of file
+}
@@ -1,11 +1,32 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <ostream>
 #include <string>
+#include <string_view>
+
+namespace chit {
+	struct IntegerChars final {
+		char8_t Data[20];
+		std::size_t Size;
+
+		std::u8string_view GetView() const noexcept;
+	};
+
+	IntegerChars ToUtf8Chars(std::int32_t integer) noexcept;
+	IntegerChars ToUtf8Chars(std::uint32_t integer) noexcept;
+	IntegerChars ToUtf8Chars(std::int64_t integer) noexcept;
+	IntegerChars ToUtf8Chars(std::uint64_t integer) noexcept;
+
+	std::basic_ostream<char8_t>& operator<<(
+		std::basic_ostream<char8_t>& stream,
+		const IntegerChars& chars);
+}
 
 namespace chit {
 	std::u8string ToUtf8String(std::int32_t integer);
 	std::u8string ToUtf8String(std::uint32_t integer);
 	std::u8string ToUtf8String(std::int64_t integer);
 	std::u8string ToUtf8String(std::uint64_t integer);
-}
\ No newline at end of file
+}
@@ -1,5 +1,10 @@
 #include <chit/Assembly.hpp>
 
+#include <chit/Instruction.hpp>
+#include <chit/Optimizer.hpp>
+#include <chit/util/String.hpp>
+
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
@@ -18,35 +23,141 @@ namespace chit {
 
 		return function.Body;
 	}
+	void Assembly::SetFrameSize(std::u8string_view name, std::size_t frameSize) noexcept {
+		assert(m_Functions.contains(name));
+
+		m_Functions.find(name)->second.FrameSize = frameSize;
+	}
+	std::size_t Assembly::GetFrameSize(std::u8string_view name) const noexcept {
+		assert(m_Functions.contains(name));
+
+		return m_Functions.find(name)->second.FrameSize;
+	}
+	std::u8string_view Assembly::GetLocalIdentifier(std::size_t slot) {
+		while (m_LocalIdentifiers.size() <= slot) {
+			m_LocalIdentifiers.push_back(u8"_ChitLangLocal" + ToUtf8String(m_LocalIdentifiers.size()));
+		}
+
+		return m_LocalIdentifiers[slot];
+	}
+	void Assembly::AddSourceName(std::u8string_view name, std::size_t slot, std::u8string_view sourceName) {
+		assert(m_Functions.contains(name));
+
+		// Slots are reused by later variables of the same size, and inlined functions add their own variables
+		auto& sourceNames = m_Functions.find(name)->second.SourceNames[GetLocalIdentifier(slot)];
+
+		if (std::find(sourceNames.begin(), sourceNames.end(), sourceName) == sourceNames.end()) {
+			sourceNames.push_back(sourceName);
+		}
+	}
+	std::span<const std::u8string_view> Assembly::GetSourceNames(std::u8string_view name, std::u8string_view local) const noexcept {
+		assert(m_Functions.contains(name));
+
+		const auto& sourceNames = m_Functions.find(name)->second.SourceNames;
 
+		if (const auto sourceNamesIter = sourceNames.find(local); sourceNamesIter != sourceNames.end()) return sourceNamesIter->second;
+		else return {};
+	}
+
+	void Assembly::Optimize() {
+		for (auto& [name, function] : m_Functions) {
+			function.Code = function.Body.str();
+			function.Body.str({});
+
+			auto& instructions = function.Instructions = ParseInstructions(function.Code);
+
+			// Peepholes run first as well, so tails are compared in their final form
+			ScheduleStack(instructions);
+
+			// Labels are numbered within the function, so they do not depend on the order of m_Functions
+			std::size_t labelCount = 0;
+
+			SimplifyControlFlow(instructions, [this, &labelCount]() -> std::u8string_view {
+				return m_Labels.emplace_back(u8"_ChitLangLabel" + ToUtf8String(labelCount++));
+			});
+			ScheduleStack(instructions);
+
+			function.IsOptimized = true;
+		}
+	}
 	std::u8string Assembly::Generate() const {
-		BodyStream stream;
+		std::u8string result;
 
 		for (const auto& [name, function] : m_Functions) {
-			if (function.HasReturn) {
-				stream << u8"func ";
-			} else {
-				stream << u8"proc ";
-			}
+			result.append(GenerateFunction(name));
+		}
 
-			stream << name << u8'(';
+		return result;
+	}
+	std::vector<std::u8string_view> Assembly::GetFunctionNames() const {
+		std::vector<std::u8string_view> names;
 
-			bool isFirst = true;
+		for (const auto& [name, function] : m_Functions) {
+			names.push_back(name);
+		}
 
-			for (const auto& paramName : function.Parameters) {
-				if (!isFirst) {
-					stream << u8", ";
-				} else {
-					isFirst = false;
-				}
+		return names;
+	}
+	bool Assembly::HasReturn(std::u8string_view name) const noexcept {
+		assert(m_Functions.contains(name));
+
+		return m_Functions.find(name)->second.HasReturn;
+	}
+	std::span<const std::u8string_view> Assembly::GetParameters(std::u8string_view name) const noexcept {
+		assert(m_Functions.contains(name));
 
-				stream << paramName;
+		return m_Functions.find(name)->second.Parameters;
+	}
+	std::span<const Instruction> Assembly::GetInstructions(std::u8string_view name) const noexcept {
+		assert(m_Functions.contains(name));
+		assert(m_Functions.find(name)->second.IsOptimized);
+
+		return m_Functions.find(name)->second.Instructions;
+	}
+	std::u8string Assembly::GenerateFunction(std::u8string_view name) const {
+		assert(m_Functions.contains(name));
+
+		const auto& function = m_Functions.find(name)->second;
+
+		if (function.IsOptimized) {
+			return GenerateFunction(name, function.Parameters, function.Instructions);
+		} else {
+			return GenerateFunction(name, function.Parameters, ParseInstructions(function.Body.view()));
+		}
+	}
+	std::u8string Assembly::GenerateFunction(
+		std::u8string_view name,
+		std::span<const std::u8string_view> parameters,
+		std::span<const Instruction> instructions) const {
+
+		assert(m_Functions.contains(name));
+
+		const auto& function = m_Functions.find(name)->second;
+		BodyStream stream;
+
+		if (function.HasReturn) {
+			stream << u8"func ";
+		} else {
+			stream << u8"proc ";
+		}
+
+		stream << name << u8'(';
+
+		bool isFirst = true;
+
+		for (const auto& paramName : parameters) {
+			if (!isFirst) {
+				stream << u8", ";
+			} else {
+				isFirst = false;
 			}
 
-			stream << u8"):\n"
-				   << function.Body.view() << u8'\n';
+			stream << paramName;
 		}
 
+		stream << u8"):\n"
+			   << WriteInstructions(instructions) << u8'\n';
+
 		return stream.str();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <chit/Compiler.hpp>
+
+#include <chit/ast/Declaration.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+
+namespace chit {
+	namespace {
+		bool HasError(std::span<const Message> messages) noexcept {
+			// Warnings are reported but do not stop the compilation
+			return std::any_of(messages.begin(), messages.end(), [](const auto& message) {
+				return message.Type == MessageType::Error;
+			});
+		}
+
+		void BindDefinitions(std::span<const RootNode* const> roots) {
+			std::unordered_map<std::u8string_view, const FunctionDefinitionNode*> definitions;
+
+			for (const auto root : roots) {
+				for (const auto& statement : root->Statements) {
+					if (const auto definition = dynamic_cast<const FunctionDefinitionNode*>(statement.get()); definition) {
+						definitions.insert({ definition->Prototype->Name, definition });
+					}
+				}
+			}
+
+			// A declaration only sees a definition in its own unit. Binding the rest lets calls across units be inlined,
+			// evaluated and specialized like any other call
+			for (const auto root : roots) {
+				for (const auto& statement : root->Statements) {
+					const auto declaration = dynamic_cast<const FunctionDeclarationNode*>(statement.get());
+					if (!declaration || !declaration->Symbol || declaration->Symbol->Definition) continue;
+
+					const auto definition = definitions.find(declaration->Name);
+					if (definition == definitions.end()) continue;
+
+					const auto definitionSymbol = definition->second->Prototype->Symbol;
+
+					if (definitionSymbol && declaration->Symbol->Type->IsEqual(definitionSymbol->Type)) {
+						declaration->Symbol->Definition = definition->second;
+					}
+				}
+			}
+		}
+	}
+}
+
+namespace chit {
+	Compiler::Unit::Unit(std::u8string source)
+		: Lexer(std::move(source)), Parser(Lexer) {}
+}
+
+namespace chit {
+	std::size_t Compiler::AddSource(std::u8string source) {
+		m_Units.push_back(std::make_unique<Unit>(std::move(source)));
+
+		return m_Units.size() - 1;
+	}
+	void Compiler::SetProfile(Profile profile) {
+		m_Profile = std::make_unique<Profile>(std::move(profile));
+		m_Linker.SetProfile(m_Profile.get());
+	}
+	void Compiler::SetMinifying(bool isMinifying) noexcept {
+		m_Linker.SetMinifying(isMinifying);
+	}
+	void Compiler::SetLinkTimeOptimizing(bool isLinkTimeOptimizing) noexcept {
+		m_IsLinkTimeOptimizing = isLinkTimeOptimizing;
+		m_Linker.SetLinkTimeOptimizing(isLinkTimeOptimizing);
+	}
+
+	bool Compiler::Compile() {
+		bool hasError = false;
+
+		for (auto& unit : m_Units) {
+			unit->Parser.Parse();
+
+			const auto lexerMessages = unit->Lexer.GetMessages();
+			const auto parserMessages = unit->Parser.GetMessages();
+
+			unit->Messages.insert(unit->Messages.end(), lexerMessages.begin(), lexerMessages.end());
+			unit->Messages.insert(unit->Messages.end(), parserMessages.begin(), parserMessages.end());
+
+			if (HasError(unit->Messages)) {
+				hasError = true;
+			}
+		}
+
+		if (hasError)
+			return false;
+
+		// Effects are summarized over the whole program before any unit is generated, so calls across units benefit too
+		std::vector<const RootNode*> roots;
+
+		for (const auto& unit : m_Units) {
+			roots.push_back(unit->Parser.GetRootNode());
+		}
+
+		m_Effects.Summarize(roots);
+
+		if (m_IsLinkTimeOptimizing) {
+			BindDefinitions(roots);
+		}
+
+		for (auto& unit : m_Units) {
+			unit->Generator.emplace(unit->Parser.GetRootNode(), m_Profile.get());
+			unit->Generator->Generate();
+
+			const auto generatorMessages = unit->Generator->GetMessages();
+
+			unit->Messages.insert(unit->Messages.end(), generatorMessages.begin(), generatorMessages.end());
+
+			if (HasError(generatorMessages)) {
+				hasError = true;
+				continue;
+			}
+
+			m_Linker.AddAssembly(unit->Generator->GetAssembly());
+		}
+
+		if (hasError)
+			return false;
+
+		m_Linker.Link();
+
+		return !HasError(m_Linker.GetMessages());
+	}
+	std::u8string_view Compiler::GetShitBF() const noexcept {
+		return m_Linker.GetShitBF();
+	}
+	std::u8string_view Compiler::GetNameMap() const noexcept {
+		return m_Linker.GetNameMap();
+	}
+	std::u8string_view Compiler::GetFrameSizes() const noexcept {
+		return m_Linker.GetFrameSizes();
+	}
+	std::size_t Compiler::GetUnitCount() const noexcept {
+		return m_Units.size();
+	}
+	std::span<const Message> Compiler::GetMessages(std::size_t unit) const noexcept {
+		assert(unit < m_Units.size());
+
+		return m_Units[unit]->Messages;
+	}
+	const LineMap& Compiler::GetLineMap(std::size_t unit) const noexcept {
+		assert(unit < m_Units.size());
+
+		return m_Units[unit]->Lexer.GetLineMap();
+	}
+}
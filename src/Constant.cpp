@@ -0,0 +1,149 @@
+#include <chit/Constant.hpp>
+
+#include <chit/Generator.hpp>
+#include <chit/util/String.hpp>
+
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace chit {
+	Constant::Constant(std::shared_ptr<BuiltinType> type, std::uint64_t value) noexcept
+		: Type(std::move(type)) {
+
+		assert(Type);
+		assert(Type->Rank);
+
+		// Wraps around like the ShitVM representation does, so folded and executed arithmetic agree
+		switch (Type->Size) {
+		case 4:
+			if (Type->IsUnsigned()) {
+				Value = static_cast<std::uint32_t>(value);
+			} else {
+				Value = static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int32_t>(value)));
+			}
+
+			break;
+
+		case 8:
+			Value = value;
+
+			break;
+
+		default:
+			assert(false);
+		}
+	}
+
+	std::int64_t Constant::GetSigned() const noexcept {
+		return static_cast<std::int64_t>(Value);
+	}
+	bool Constant::operator==(const Constant& other) const noexcept {
+		return Type->IsEqual(other.Type) && Value == other.Value;
+	}
+
+	bool Constant::IsZero() const noexcept {
+		return Value == 0;
+	}
+
+	Constant Constant::Convert(const TypePtr& type) const noexcept {
+		return Constant(IsBuiltinType(type), Value);
+	}
+	void Constant::Generate(GeneratorContext& context) const {
+		assert(context.Stream);
+
+		*context.Stream << u8"push ";
+
+		switch (Type->Size) {
+		case 4:
+			if (Type->IsUnsigned()) {
+				*context.Stream << ToUtf8Chars(static_cast<std::uint32_t>(Value));
+			} else {
+				*context.Stream << ToUtf8Chars(static_cast<std::int32_t>(Value));
+			}
+
+			*context.Stream << u8"i\n";
+
+			break;
+
+		case 8:
+			if (Type->IsUnsigned()) {
+				*context.Stream << ToUtf8Chars(Value);
+			} else {
+				*context.Stream << ToUtf8Chars(GetSigned());
+			}
+
+			*context.Stream << u8"l\n";
+
+			break;
+
+		default:
+			assert(false);
+		}
+	}
+
+	std::optional<Constant> Constant::Evaluate(
+		TokenType operator_,
+		const Constant& left,
+		const Constant& right,
+		const TypePtr& resultType) {
+
+		assert(left.Type == right.Type);
+
+		const auto resultBuiltinType = IsBuiltinType(resultType);
+		const auto isUnsigned = left.Type->IsUnsigned();
+
+		const auto compare = [&](auto comparer) {
+			const bool result = isUnsigned ?
+				comparer(left.Value, right.Value) :
+				comparer(left.GetSigned(), right.GetSigned());
+
+			return Constant(resultBuiltinType, result ? 1 : 0);
+		};
+
+		switch (operator_) {
+		case TokenType::Addition:
+			return Constant(resultBuiltinType, left.Value + right.Value);
+		case TokenType::Subtraction:
+			return Constant(resultBuiltinType, left.Value - right.Value);
+		case TokenType::Multiplication:
+			return Constant(resultBuiltinType, left.Value * right.Value);
+
+		case TokenType::Division:
+		case TokenType::Modulo: {
+			// Faults are left to happen at runtime
+			if (right.IsZero()) return std::nullopt;
+
+			if (isUnsigned) {
+				return Constant(resultBuiltinType,
+					operator_ == TokenType::Division ?
+					left.Value / right.Value :
+					left.Value % right.Value);
+			}
+
+			if (left.GetSigned() == std::numeric_limits<std::int64_t>::min() &&
+				right.GetSigned() == -1) return std::nullopt;
+
+			return Constant(resultBuiltinType, static_cast<std::uint64_t>(
+				operator_ == TokenType::Division ?
+				left.GetSigned() / right.GetSigned() :
+				left.GetSigned() % right.GetSigned()));
+		}
+
+		case TokenType::Equivalence:
+			return Constant(resultBuiltinType, left.Value == right.Value ? 1 : 0);
+		case TokenType::GreaterThan:
+			return compare(std::greater<>{});
+		case TokenType::LessThan:
+			return compare(std::less<>{});
+		case TokenType::GreaterThanOrEqual:
+			return compare(std::greater_equal<>{});
+		case TokenType::LessThanOrEqual:
+			return compare(std::less_equal<>{});
+
+		default:
+			return std::nullopt;
+		}
+	}
+}
\ No newline at end of file
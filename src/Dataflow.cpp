@@ -0,0 +1,284 @@
+#include <chit/Dataflow.hpp>
+
+#include <chit/Symbol.hpp>
+
+#include <cassert>
+#include <deque>
+#include <string_view>
+#include <utility>
+
+namespace chit {
+	namespace {
+		constexpr std::size_t WordBits = 64;
+
+		std::size_t GetWordCount(std::size_t size) noexcept {
+			return (size + WordBits - 1) / WordBits;
+		}
+	}
+
+	BitVector::BitVector(std::size_t size, bool value)
+		: m_Words(GetWordCount(size), value ? ~std::uint64_t{} : 0), m_Size(size) {
+
+		ClearPadding();
+	}
+
+	BitVector& BitVector::operator|=(const BitVector& other) noexcept {
+		assert(m_Size == other.m_Size);
+
+		for (std::size_t i = 0; i < m_Words.size(); ++i) {
+			m_Words[i] |= other.m_Words[i];
+		}
+
+		return *this;
+	}
+	BitVector& BitVector::operator&=(const BitVector& other) noexcept {
+		assert(m_Size == other.m_Size);
+
+		for (std::size_t i = 0; i < m_Words.size(); ++i) {
+			m_Words[i] &= other.m_Words[i];
+		}
+
+		return *this;
+	}
+
+	std::size_t BitVector::GetSize() const noexcept {
+		return m_Size;
+	}
+	void BitVector::Resize(std::size_t size, bool value) {
+		if (value && m_Size % WordBits != 0) {
+			m_Words.back() |= ~std::uint64_t{} << (m_Size % WordBits);
+		}
+
+		m_Words.resize(GetWordCount(size), value ? ~std::uint64_t{} : 0);
+		m_Size = size;
+
+		ClearPadding();
+	}
+
+	bool BitVector::Test(std::size_t index) const noexcept {
+		assert(index < m_Size);
+
+		return (m_Words[index / WordBits] >> (index % WordBits)) & 1;
+	}
+	void BitVector::Set(std::size_t index) noexcept {
+		assert(index < m_Size);
+
+		m_Words[index / WordBits] |= std::uint64_t{ 1 } << (index % WordBits);
+	}
+	void BitVector::Reset(std::size_t index) noexcept {
+		assert(index < m_Size);
+
+		m_Words[index / WordBits] &= ~(std::uint64_t{ 1 } << (index % WordBits));
+	}
+	void BitVector::Subtract(const BitVector& other) noexcept {
+		assert(m_Size == other.m_Size);
+
+		for (std::size_t i = 0; i < m_Words.size(); ++i) {
+			m_Words[i] &= ~other.m_Words[i];
+		}
+	}
+
+	void BitVector::ClearPadding() noexcept {
+		// Bits past the end stay zero, so whole words can be compared
+		if (m_Size % WordBits != 0) {
+			m_Words.back() &= ~(~std::uint64_t{} << (m_Size % WordBits));
+		}
+	}
+}
+
+namespace chit {
+	std::vector<BasicBlock> FindBasicBlocks(const std::vector<Instruction>& instructions) {
+		std::vector<BasicBlock> result;
+		std::unordered_map<std::u8string_view, std::size_t> labels;
+
+		for (std::size_t i = 0; i < instructions.size(); ++i) {
+			const auto isLeader =
+				i == 0 ||
+				instructions[i].IsLabel() ||
+				instructions[i - 1].IsJump() || instructions[i - 1].IsTerminator();
+
+			if (isLeader) {
+				if (!result.empty()) {
+					result.back().End = i;
+				}
+
+				result.push_back({ .Begin = i });
+			}
+			if (instructions[i].IsLabel()) {
+				labels[instructions[i].Operand] = result.size() - 1;
+			}
+		}
+
+		if (!result.empty()) {
+			result.back().End = instructions.size();
+		}
+
+		for (std::size_t i = 0; i < result.size(); ++i) {
+			const auto& last = instructions[result[i].End - 1];
+
+			if (last.IsJump()) {
+				result[i].Successors.push_back(labels.at(last.Operand));
+			}
+			if (!last.IsTerminator() && i + 1 < result.size()) {
+				result[i].Successors.push_back(i + 1);
+			}
+
+			for (const auto successor : result[i].Successors) {
+				result[successor].Predecessors.push_back(i);
+			}
+		}
+
+		return result;
+	}
+}
+
+namespace chit {
+	DataflowResult SolveDataflow(const std::vector<BasicBlock>& blocks, const DataflowProblem& problem) {
+		assert(problem.Gen.size() == blocks.size());
+		assert(problem.Kill.size() == blocks.size());
+		assert(problem.Boundary.GetSize() == problem.Size);
+
+		const auto isForward = problem.Direction == DataflowDirection::Forward;
+		const auto isUnion = problem.Meet == DataflowMeet::Union;
+
+		// Entry and Exit follow the direction of the analysis
+		std::vector<BitVector> entry(blocks.size(), BitVector(problem.Size, !isUnion));
+		std::vector<BitVector> exit(blocks.size(), BitVector(problem.Size, !isUnion));
+
+		// Visiting blocks in the order values flow through them usually reaches the fixed point in one pass
+		std::deque<std::size_t> worklist;
+		std::vector<bool> isQueued(blocks.size(), true);
+
+		for (std::size_t i = 0; i < blocks.size(); ++i) {
+			worklist.push_back(isForward ? i : blocks.size() - 1 - i);
+		}
+
+		while (!worklist.empty()) {
+			const auto block = worklist.front();
+			worklist.pop_front();
+			isQueued[block] = false;
+
+			const auto& inputs = isForward ? blocks[block].Predecessors : blocks[block].Successors;
+			const auto& outputs = isForward ? blocks[block].Successors : blocks[block].Predecessors;
+			const auto isBoundary = isForward ? block == 0 : inputs.empty();
+
+			auto value = isBoundary ? problem.Boundary : BitVector(problem.Size, !isUnion);
+
+			for (const auto input : inputs) {
+				if (isUnion) {
+					value |= exit[input];
+				} else {
+					value &= exit[input];
+				}
+			}
+
+			entry[block] = value;
+			value.Subtract(problem.Kill[block]);
+			value |= problem.Gen[block];
+
+			if (value == exit[block]) continue;
+
+			exit[block] = std::move(value);
+
+			for (const auto output : outputs) {
+				if (!isQueued[output]) {
+					worklist.push_back(output);
+					isQueued[output] = true;
+				}
+			}
+		}
+
+		if (isForward) {
+			return { .In = std::move(entry), .Out = std::move(exit) };
+		} else {
+			return { .In = std::move(exit), .Out = std::move(entry) };
+		}
+	}
+}
+
+namespace chit {
+	void DefiniteAssignment::Declare(VariableSymbol* symbol, bool isAssigned) {
+		assert(symbol);
+		assert(!m_Indices.contains(symbol));
+
+		const auto index = m_Variables.size();
+
+		m_Indices[symbol] = index;
+		m_Variables.push_back(symbol);
+		m_IsWeakened.Resize(m_Variables.size());
+
+		Grow(m_State);
+
+		if (isAssigned) {
+			m_State.Assigned.Set(index);
+			m_State.MaybeAssigned.Set(index);
+		}
+
+		symbol->State = isAssigned ? VariableState::Initalized : VariableState::Uninitialized;
+	}
+	void DefiniteAssignment::Assign(VariableSymbol* symbol) {
+		const auto index = m_Indices.find(symbol);
+		if (index == m_Indices.end() || !m_State.IsReachable) return;
+
+		m_State.Assigned.Set(index->second);
+		m_State.MaybeAssigned.Set(index->second);
+
+		if (!m_IsWeakened.Test(index->second)) {
+			symbol->State = VariableState::Initalized;
+		}
+	}
+	void DefiniteAssignment::Read(VariableSymbol* symbol) {
+		const auto index = m_Indices.find(symbol);
+		if (index == m_Indices.end() || !m_State.IsReachable) return;
+
+		if (m_State.Assigned.Test(index->second)) return;
+
+		// The weakest state seen by any read is kept
+		const auto state = m_State.MaybeAssigned.Test(index->second) ?
+			VariableState::Unknown : VariableState::Uninitialized;
+
+		if (!m_IsWeakened.Test(index->second) || state < symbol->State) {
+			symbol->State = state;
+		}
+
+		m_IsWeakened.Set(index->second);
+	}
+	void DefiniteAssignment::Terminate() noexcept {
+		m_State.IsReachable = false;
+	}
+	bool DefiniteAssignment::IsWeakened(VariableSymbol* symbol) const {
+		const auto index = m_Indices.find(symbol);
+
+		return index != m_Indices.end() && m_IsWeakened.Test(index->second);
+	}
+
+	DefiniteAssignment::State DefiniteAssignment::Save() const {
+		return m_State;
+	}
+	void DefiniteAssignment::Restore(State state) {
+		m_State = std::move(state);
+
+		Grow(m_State);
+	}
+	void DefiniteAssignment::Merge(State state) {
+		Grow(state);
+		Grow(m_State);
+
+		// A path that never reaches the join point adds nothing to it
+		if (!state.IsReachable) return;
+		if (!m_State.IsReachable) {
+			m_State = std::move(state);
+
+			return;
+		}
+
+		m_State.Assigned &= state.Assigned;
+		m_State.MaybeAssigned |= state.MaybeAssigned;
+	}
+
+	void DefiniteAssignment::Grow(State& state) const {
+		// Variables declared after the state was saved are out of scope at the join point
+		state.Assigned.Resize(m_Variables.size());
+		state.MaybeAssigned.Resize(m_Variables.size());
+	}
+}
\ No newline at end of file
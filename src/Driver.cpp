@@ -0,0 +1,133 @@
+#include <chit/Driver.hpp>
+
+#include <chit/Compiler.hpp>
+
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+
+namespace chit {
+	std::optional<DriverOptions> ParseArguments(const std::vector<std::string>& arguments) {
+		DriverOptions result;
+
+		for (std::size_t i = 0; i < arguments.size(); ++i) {
+			const std::string_view argument = arguments[i];
+
+			if (argument == "-o" && i + 1 < arguments.size()) {
+				result.OutputPath = arguments[++i];
+			} else if (argument.starts_with("-fprofile-use=")) {
+				result.ProfilePath = argument.substr(argument.find('=') + 1);
+			} else if (argument == "-flto") {
+				result.IsLinkTimeOptimizing = true;
+			} else if (argument == "-fminify-names") {
+				result.IsMinifying = true;
+			} else if (argument.starts_with("-fname-map=")) {
+				result.NameMapPath = argument.substr(argument.find('=') + 1);
+				result.IsMinifying = true;
+			} else if (argument.starts_with("-fframe-sizes=")) {
+				result.FrameSizesPath = argument.substr(argument.find('=') + 1);
+			} else {
+				result.InputPaths.push_back(arguments[i]);
+			}
+		}
+
+		if (result.InputPaths.empty()) return std::nullopt;
+		else return result;
+	}
+	std::vector<std::string> GetReadPaths(const DriverOptions& options) {
+		auto result = options.InputPaths;
+
+		if (!options.ProfilePath.empty()) {
+			result.push_back(options.ProfilePath);
+		}
+
+		return result;
+	}
+
+	DriverResult RunDriver(const DriverOptions& options, const FileReader& readFile) {
+		DriverResult result;
+		std::ostringstream errors;
+
+		const auto fail = [&](const std::string& path, std::string_view message) {
+			errors << path << ": error: " << message << '\n';
+
+			result.ExitCode = EXIT_FAILURE;
+			result.Errors = errors.str();
+			result.Files.clear();
+
+			return result;
+		};
+
+		// All sources share one process, so build systems can hand over a whole batch at once
+		Compiler compiler;
+
+		compiler.SetMinifying(options.IsMinifying);
+		compiler.SetLinkTimeOptimizing(options.IsLinkTimeOptimizing);
+
+		if (!options.ProfilePath.empty()) {
+			const auto profileText = readFile(options.ProfilePath);
+			if (!profileText) return fail(options.ProfilePath, "Failed to open file");
+
+			Profile profile;
+
+			if (!profile.Parse(std::u8string(profileText->begin(), profileText->end())))
+				return fail(options.ProfilePath, "Invalid profile");
+
+			compiler.SetProfile(std::move(profile));
+		}
+
+		for (const auto& inputPath : options.InputPaths) {
+			const auto source = readFile(inputPath);
+			if (!source) return fail(inputPath, "Failed to open file");
+
+			compiler.AddSource(std::u8string(source->begin(), source->end()));
+		}
+
+		const bool isSucceeded = compiler.Compile();
+
+		for (std::size_t i = 0; i < compiler.GetUnitCount(); ++i) {
+			for (const auto& message : compiler.GetMessages(i)) {
+				const auto location = compiler.GetLineMap(i).GetLocation(message.Offset);
+
+				errors <<
+					options.InputPaths[i] << ':' << location.Line << ':' << location.Column <<
+					(message.Type == MessageType::Warning ? ": warning: " : ": error: ") <<
+					std::string(message.Data.begin(), message.Data.end()) << '\n';
+			}
+		}
+
+		result.Errors = errors.str();
+
+		if (!isSucceeded) {
+			result.ExitCode = EXIT_FAILURE;
+
+			return result;
+		}
+
+		const auto write = [&](const std::string& path, std::u8string_view contents) {
+			result.Files.push_back({ path, std::string(contents.begin(), contents.end()) });
+		};
+
+		const auto shitBF = compiler.GetShitBF();
+
+		if (options.OutputPath.empty()) {
+			result.Output.assign(shitBF.begin(), shitBF.end());
+		} else {
+			write(options.OutputPath, shitBF);
+		}
+
+		// Each line of the map holds a function, a short name in it, the name an unminified build gives it and the source variables it holds
+		if (!options.NameMapPath.empty()) {
+			write(options.NameMapPath, compiler.GetNameMap());
+		}
+
+		// Each line of the report holds a function and the number of frame slots the generator gave it
+		if (!options.FrameSizesPath.empty()) {
+			write(options.FrameSizesPath, compiler.GetFrameSizes());
+		}
+
+		result.ExitCode = EXIT_SUCCESS;
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <chit/Effect.hpp>
+
+#include <chit/ast/Declaration.hpp>
+#include <chit/ast/Node.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace chit {
+	bool Effect::IsPure() const noexcept {
+		return !ReadsGlobals && !WritesGlobals && !MayNotTerminate && !MayTrap;
+	}
+	bool Effect::HasSideEffect() const noexcept {
+		return WritesGlobals || MayNotTerminate || MayTrap;
+	}
+
+	Effect& Effect::operator|=(const Effect& other) noexcept {
+		ReadsGlobals |= other.ReadsGlobals;
+		WritesGlobals |= other.WritesGlobals;
+		MayNotTerminate |= other.MayNotTerminate;
+		MayTrap |= other.MayTrap;
+
+		return *this;
+	}
+
+	Effect Effect::GetUnknown() noexcept {
+		return {
+			.ReadsGlobals = true,
+			.WritesGlobals = true,
+			.MayNotTerminate = true,
+			.MayTrap = true,
+		};
+	}
+}
+
+namespace chit {
+	namespace {
+		struct CallGraphNode final {
+			const FunctionDefinitionNode* Definition;
+			std::size_t Index = static_cast<std::size_t>(-1);
+			std::size_t LowLink = 0;
+			bool IsOnStack = false;
+		};
+
+		class CallGraph final {
+		private:
+			std::unordered_map<std::u8string_view, CallGraphNode> m_Nodes;
+			std::vector<CallGraphNode*> m_Stack;
+			std::size_t m_NextIndex = 0;
+
+		public:
+			explicit CallGraph(std::span<const RootNode* const> roots) {
+				for (const auto root : roots) {
+					for (const auto& statement : root->Statements) {
+						if (const auto definition = dynamic_cast<const FunctionDefinitionNode*>(statement.get()); definition) {
+							m_Nodes.insert({ definition->Prototype->Name, { .Definition = definition } });
+						}
+					}
+				}
+			}
+
+		public:
+			// Tarjan's algorithm, which completes the components of callees before those of their callers
+			template<typename F>
+			void VisitComponents(F&& visitor) {
+				for (auto& [name, node] : m_Nodes) {
+					if (node.Index == static_cast<std::size_t>(-1)) {
+						Visit(node, visitor);
+					}
+				}
+			}
+			const CallGraphNode* Find(std::u8string_view name) const {
+				const auto nodeIter = m_Nodes.find(name);
+
+				if (nodeIter != m_Nodes.end()) return &nodeIter->second;
+				else return nullptr;
+			}
+
+		private:
+			template<typename F>
+			void Visit(CallGraphNode& node, F& visitor) {
+				node.Index = node.LowLink = m_NextIndex++;
+				node.IsOnStack = true;
+				m_Stack.push_back(&node);
+
+				for (const auto callee : node.Definition->Callees) {
+					const auto calleeIter = m_Nodes.find(callee);
+					if (calleeIter == m_Nodes.end()) continue;
+
+					auto& calleeNode = calleeIter->second;
+
+					if (calleeNode.Index == static_cast<std::size_t>(-1)) {
+						Visit(calleeNode, visitor);
+
+						node.LowLink = std::min(node.LowLink, calleeNode.LowLink);
+					} else if (calleeNode.IsOnStack) {
+						node.LowLink = std::min(node.LowLink, calleeNode.Index);
+					}
+				}
+
+				if (node.LowLink != node.Index) return;
+
+				std::vector<const FunctionDefinitionNode*> component;
+
+				while (true) {
+					const auto member = m_Stack.back();
+
+					m_Stack.pop_back();
+					member->IsOnStack = false;
+					component.push_back(member->Definition);
+
+					if (member == &node) break;
+				}
+
+				visitor(component);
+			}
+		};
+	}
+
+	void EffectTable::Summarize(std::span<const RootNode* const> roots) {
+		CallGraph graph(roots);
+
+		graph.VisitComponents([&](const std::vector<const FunctionDefinitionNode*>& component) {
+			Effect effect;
+
+			for (const auto definition : component) {
+				effect |= definition->LocalEffect;
+
+				for (const auto callee : definition->Callees) {
+					const auto isInComponent = std::any_of(component.begin(), component.end(), [callee](const auto member) {
+						return member->Prototype->Name == callee;
+					});
+
+					// Recursion is not known to terminate
+					if (isInComponent) {
+						effect.MayNotTerminate = true;
+					} else if (const auto calleeEffect = Find(callee); calleeEffect) {
+						effect |= *calleeEffect;
+					} else {
+						effect |= Effect::GetUnknown();
+					}
+				}
+			}
+
+			for (const auto definition : component) {
+				m_Effects[std::u8string(definition->Prototype->Name)] = effect;
+			}
+		});
+
+		// Every unit sees the summaries of functions defined in the others through its declarations
+		for (const auto root : roots) {
+			for (const auto& statement : root->Statements) {
+				const FunctionDeclarationNode* declaration = dynamic_cast<const FunctionDeclarationNode*>(statement.get());
+
+				if (const auto definition = dynamic_cast<const FunctionDefinitionNode*>(statement.get()); definition) {
+					declaration = definition->Prototype.get();
+				}
+
+				if (declaration && declaration->Symbol) {
+					declaration->Symbol->Effect = Find(declaration->Name);
+				}
+			}
+		}
+	}
+	std::optional<Effect> EffectTable::Find(std::u8string_view function) const {
+		if (const auto effectIter = m_Effects.find(std::u8string(function));
+			effectIter != m_Effects.end()) {
+
+			return effectIter->second;
+		} else return std::nullopt;
+	}
+}
\ No newline at end of file
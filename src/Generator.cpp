@@ -1,30 +1,104 @@
 #include <chit/Generator.hpp>
 
+#include <chit/ast/Expression.hpp>
 #include <chit/ast/Node.hpp>
+#include <chit/util/String.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <random>
+#include <utility>
+
+namespace chit {
+	namespace {
+		bool IsReading(const ExpressionNode& expression, const VariableSymbol* symbol) {
+			if (const auto identifier = dynamic_cast<const IdentifierNode*>(&expression); identifier) {
+				return IsVariableSymbol(identifier->Symbol) == symbol;
+			} else if (const auto binaryOperator = dynamic_cast<const BinaryOperatorNode*>(&expression); binaryOperator) {
+				return IsReading(*binaryOperator->Left, symbol) || IsReading(*binaryOperator->Right, symbol);
+			} else if (const auto call = dynamic_cast<const FunctionCallNode*>(&expression); call) {
+				return std::any_of(call->Arguments.begin(), call->Arguments.end(), [symbol](const auto& argument) {
+					return IsReading(*argument, symbol);
+				});
+			} else {
+				return false;
+			}
+		}
+	}
+}
+
+namespace chit {
+	std::size_t Frame::AllocateSlot(const TypePtr& type) {
+		const auto builtinType = IsBuiltinType(type);
+
+		assert(builtinType);
+		assert(!builtinType->IsVoid());
+
+		// A slot is only reused for the same representation, so it never changes type in ShitVM
+		for (std::size_t i = 0; i < m_Slots.size(); ++i) {
+			if (!m_Slots[i].IsUsed && m_Slots[i].Size == builtinType->Size) {
+				m_Slots[i].IsUsed = true;
+
+				return i;
+			}
+		}
+
+		m_Slots.push_back({
+			.Size = builtinType->Size,
+			.IsUsed = true,
+		});
+
+		return m_Slots.size() - 1;
+	}
+	void Frame::FreeSlot(std::size_t slot) noexcept {
+		assert(slot < m_Slots.size());
+		assert(m_Slots[slot].IsUsed);
+
+		m_Slots[slot].IsUsed = false;
+	}
+	std::size_t Frame::GetSize() const noexcept {
+		return m_Slots.size();
+	}
+}
+
+namespace chit {
+	void FlowState::Merge(FlowState other) {
+		// A path that never reaches the join point adds nothing to it
+		if (!other.IsReachable) return;
+		if (!IsReachable) {
+			*this = std::move(other);
+
+			return;
+		}
+
+		std::erase_if(Values, [&other](const auto& value) {
+			const auto otherValue = other.Values.find(value.first);
+
+			return otherValue == other.Values.end() || otherValue->second != value.second;
+		});
+		std::erase_if(Expressions, [&other](const auto& expression) {
+			return std::find(other.Expressions.begin(), other.Expressions.end(), expression) == other.Expressions.end();
+		});
+	}
+}
 
 namespace chit {
 	std::u8string_view GeneratorContext::CreateTempIdentifier() {
-		if (Parent && Parent->Stream == Stream)
+		// Labels are local to a function, so identifiers only have to be unique within one
+		if (Parent && Parent->Function == Function)
 			return Parent->CreateTempIdentifier();
 
+		// Identifiers are numbered in the order they are created, so the same source always gives the same output
 		while (true) {
-			thread_local std::mt19937 mt(std::random_device{}());
-			thread_local std::uniform_int_distribution<std::uint16_t> dist(0, 0xFFFF);
+			auto identifier = u8"_ChitLangTemp" + ToUtf8String(NextTempIdentifier++);
 
-			const std::string randomName = "_ChitLangTemp" + std::to_string(dist(mt));
-			const std::u8string utf8RandomName(randomName.begin(), randomName.end());
-
-			if (!HasTempIdentifier(utf8RandomName)) {
-				return *TempIdentifiers.insert(std::move(utf8RandomName)).first;
+			if (!HasTempIdentifier(identifier)) {
+				return *TempIdentifiers.insert(std::move(identifier)).first;
 			}
 		}
 	}
 	void GeneratorContext::DeleteTempIdentifier(std::u8string_view identifier) {
-		if (Parent && Parent->Stream == Stream) {
+		if (Parent && Parent->Function == Function) {
 			Parent->DeleteTempIdentifier(identifier);
 			return;
 		}
@@ -34,6 +108,138 @@ namespace chit {
 		TempIdentifiers.erase(std::u8string(identifier));
 	}
 
+	std::size_t GeneratorContext::CreateLocal(const VariableSymbol* symbol, const TypePtr& type) {
+		assert(Frame);
+		assert(!Locals.contains(symbol));
+
+		const auto slot = Frame->AllocateSlot(type);
+
+		if (symbol) {
+			Locals[symbol] = slot;
+
+			// The name map shows which source variables a local holds
+			if (Function) {
+				Assembly.AddSourceName(Function->Name, slot, symbol->Name);
+			}
+		}
+
+		return slot;
+	}
+	std::optional<std::size_t> GeneratorContext::FindLocal(const VariableSymbol* symbol) const {
+		if (const auto localIter = Locals.find(symbol);
+			localIter != Locals.end()) {
+
+			return localIter->second;
+		} else if (const auto aliasIter = Aliases.find(symbol);
+			aliasIter != Aliases.end()) {
+
+			return aliasIter->second;
+		} else if (Parent) {
+			return Parent->FindLocal(symbol);
+		} else {
+			return std::nullopt;
+		}
+	}
+	void GeneratorContext::DeleteLocals() noexcept {
+		assert(Frame);
+
+		// Later initializers can no longer reuse the freed slots
+		std::erase_if(GetFlow().Expressions, [this](const auto& expression) {
+			return Locals.contains(expression.second);
+		});
+
+		for (const auto& [symbol, slot] : Locals) {
+			Frame->FreeSlot(slot);
+		}
+
+		Locals.clear();
+	}
+	std::optional<Constant> GeneratorContext::FindConstant(const VariableSymbol* symbol) const {
+		if (const auto constantIter = Constants.find(symbol);
+			constantIter != Constants.end()) {
+
+			return constantIter->second;
+		} else if (const auto valueIter = Flow.Values.find(symbol);
+			valueIter != Flow.Values.end()) {
+
+			return valueIter->second;
+		} else if (Parent) {
+			return Parent->FindConstant(symbol);
+		} else {
+			return std::nullopt;
+		}
+	}
+
+	bool GeneratorContext::AssignConstant(const VariableSymbol* symbol, const Constant& value) {
+		if (const auto constantIter = Constants.find(symbol);
+			constantIter != Constants.end()) {
+
+			constantIter->second = value;
+
+			return true;
+		} else if (Parent) {
+			return Parent->AssignConstant(symbol, value);
+		} else {
+			return false;
+		}
+	}
+
+	std::optional<Range> GeneratorContext::FindRange(const VariableSymbol* symbol) const {
+		if (const auto rangeIter = Ranges.find(symbol);
+			rangeIter != Ranges.end()) {
+
+			return rangeIter->second;
+		} else if (Parent) {
+			return Parent->FindRange(symbol);
+		} else {
+			return std::nullopt;
+		}
+	}
+
+	std::optional<std::size_t> GeneratorContext::FindPureCall(const FunctionCallNode* call) const {
+		for (const auto& [pureCall, slot] : PureCalls) {
+			if (pureCall->IsEquivalent(*this, *call)) return slot;
+		}
+
+		if (Parent) return Parent->FindPureCall(call);
+		else return std::nullopt;
+	}
+
+	FlowState& GeneratorContext::GetFlow() noexcept {
+		// Every context generating the same function shares one state, as CreateTempIdentifier shares its labels
+		if (Parent && Parent->Function == Function) return Parent->GetFlow();
+		else return Flow;
+	}
+	void GeneratorContext::AssignValue(const VariableSymbol* symbol, std::optional<Constant> value) {
+		auto& flow = GetFlow();
+
+		if (value) {
+			flow.Values.insert_or_assign(symbol, std::move(*value));
+		} else {
+			flow.Values.erase(symbol);
+		}
+
+		std::erase_if(flow.Expressions, [symbol](const auto& expression) {
+			return IsReading(*expression.first, symbol);
+		});
+	}
+	std::optional<std::size_t> GeneratorContext::FindExpression(const ExpressionNode& expression, const TypePtr& type) const {
+		// The slot is found from this context, where the variable holding the value is still in scope
+		for (auto context = this; context; context = context->Parent) {
+			for (const auto& [initializer, symbol] : context->Flow.Expressions) {
+				if (symbol->Type->IsEqual(type) && initializer->IsEquivalent(*this, expression)) return FindLocal(symbol);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	bool GeneratorContext::IsGenerating(const FunctionDefinitionNode* definition) const noexcept {
+		if (InlinedFunction == definition) return true;
+		else if (Function && Function->Definition == definition) return true;
+		else if (Parent) return Parent->IsGenerating(definition);
+		else return false;
+	}
 	bool GeneratorContext::HasTempIdentifier(const std::u8string& identifier) {
 		return
 			TempIdentifiers.contains(identifier) ||
@@ -42,8 +248,8 @@ namespace chit {
 }
 
 namespace chit {
-	Generator::Generator(const RootNode* rootNode) noexcept
-		: m_RootNode(rootNode) {
+	Generator::Generator(const RootNode* rootNode, const Profile* profile) noexcept
+		: m_RootNode(rootNode), m_Profile(profile) {
 
 		assert(m_RootNode != nullptr);
 	}
@@ -55,10 +261,12 @@ namespace chit {
 
 		GeneratorContext context{
 			.Assembly = *m_Assembly,
+			.Profile = m_Profile,
 			.Messages = m_Messages,
 		};
 
 		m_RootNode->Generate(context);
+		m_Assembly->Optimize();
 	}
 	const Assembly* Generator::GetAssembly() const noexcept {
 		return &*m_Assembly;
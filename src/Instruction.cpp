@@ -0,0 +1,72 @@
+#include <chit/Instruction.hpp>
+
+#include <cassert>
+
+namespace chit {
+	bool Instruction::IsLabel() const noexcept {
+		return Mnemonic.empty();
+	}
+	bool Instruction::IsJump() const noexcept {
+		return
+			Is(u8"jmp") ||
+			Is(u8"je") || Is(u8"jne") ||
+			Is(u8"ja") || Is(u8"jae") ||
+			Is(u8"jb") || Is(u8"jbe");
+	}
+	bool Instruction::IsTerminator() const noexcept {
+		return Is(u8"jmp") || Is(u8"ret");
+	}
+	bool Instruction::Is(std::u8string_view mnemonic) const noexcept {
+		return Mnemonic == mnemonic;
+	}
+	bool Instruction::Is(std::u8string_view mnemonic, std::u8string_view operand) const noexcept {
+		return Mnemonic == mnemonic && Operand == operand;
+	}
+
+	std::vector<Instruction> ParseInstructions(std::u8string_view code) {
+		std::vector<Instruction> result;
+
+		while (!code.empty()) {
+			const auto lineEnd = code.find(u8'\n');
+			const auto line = code.substr(0, lineEnd);
+
+			code.remove_prefix(lineEnd == std::u8string_view::npos ? code.size() : lineEnd + 1);
+
+			if (line.empty()) continue;
+
+			if (line.back() == u8':') {
+				result.push_back({
+					.Operand = line.substr(0, line.size() - 1),
+				});
+			} else if (const auto space = line.find(u8' '); space != std::u8string_view::npos) {
+				result.push_back({
+					.Mnemonic = line.substr(0, space),
+					.Operand = line.substr(space + 1),
+				});
+			} else {
+				result.push_back({
+					.Mnemonic = line,
+				});
+			}
+		}
+
+		return result;
+	}
+	std::u8string WriteInstructions(std::span<const Instruction> instructions) {
+		std::u8string result;
+
+		for (const auto& instruction : instructions) {
+			if (instruction.IsLabel()) {
+				assert(!instruction.Operand.empty());
+
+				result.append(instruction.Operand).append(u8":\n");
+			} else if (instruction.Operand.empty()) {
+				result.append(instruction.Mnemonic).append(u8"\n");
+			} else {
+				result.append(instruction.Mnemonic).append(u8" ").append(instruction.Operand).append(u8"\n");
+			}
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include <chit/Interpreter.hpp>
+
+#include <chit/Generator.hpp>
+#include <chit/ast/Declaration.hpp>
+
+#include <cassert>
+
+namespace chit {
+	std::optional<Constant> Interpreter::Call(const FunctionDefinitionNode* definition, std::span<const Constant> arguments) {
+		assert(arguments.size() == definition->Prototype->Parameters.size());
+
+		if (m_Depth == MaxDepth || !Step()) return std::nullopt;
+
+		// Variables live in the constants of the contexts, so the expressions are evaluated just like during generation
+		GeneratorContext context{
+			.Assembly = m_Assembly,
+			.Interpreter = this,
+			.Messages = m_Messages,
+		};
+
+		for (std::size_t i = 0; i < arguments.size(); ++i) {
+			if (const auto symbol = definition->GetParameterSymbol(i); symbol) {
+				context.Constants.insert({ symbol, arguments[i] });
+			}
+		}
+
+		++m_Depth;
+
+		const auto completion = definition->Body->Execute(context);
+
+		--m_Depth;
+
+		if (!completion || !completion->IsReturn || !completion->Value) return std::nullopt;
+		else return completion->Value->Convert(definition->Prototype->ReturnType->Type);
+	}
+	bool Interpreter::Step() noexcept {
+		return m_Steps++ < MaxSteps;
+	}
+}
\ No newline at end of file
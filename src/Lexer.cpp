@@ -5,53 +5,56 @@
 #include <cassert>
 #include <cctype>
 #include <cstdint>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 #include <utf8.h>
 #include <utility>
 
 namespace chit {
-	Lexer::Lexer(std::u8string source) noexcept
+	Lexer::Lexer(std::u8string source)
 		: m_Source(std::move(source)) {
+
+		if (m_Source.empty() || m_Source.back() != u8'\n') {
+			m_Source.push_back(u8'\n');
+		}
+
 		m_Current = m_Source.begin();
+		m_LineMap = LineMap(m_Source);
 	}
 
 	void Lexer::Lex() {
 		assert(m_Current == m_Source.begin());
 		assert(m_Tokens.empty());
 
-		if (m_Source.back() != u8'\n') {
-			m_Source.push_back(u8'\n');
-			m_Current = m_Source.begin();
-		}
-
+		do {
+			m_Tokens.push_back(NextToken());
+		} while (m_Tokens.back().Type != TokenType::Eof);
+	}
+	Token Lexer::NextToken() {
 		while (m_Current < m_Source.end()) {
 			const auto cursor = NextCursor();
 			const auto& codepoint = cursor.Codepoint;
 
-			if (codepoint == U'\n') {
-				++m_Line;
-				m_Column = 0;
-
-				continue;
-			} else if (std::isspace(codepoint)) {
+			if (std::isspace(codepoint)) {
 				continue;
 			}
 
 			if (std::isdigit(codepoint)) {
-				LexNumber(cursor);
+				return LexNumber(cursor);
 			} else if (IsSpecialSymbol(codepoint)) {
-				LexSpeicalSymbol(cursor);
+				if (auto token = LexSpeicalSymbol(cursor); token) {
+					return *token;
+				}
 			} else {
-				LexIdentifier(cursor);
+				return LexIdentifier(cursor);
 			}
 		}
 
-		m_Tokens.push_back({
+		return {
 			.Type = TokenType::Eof,
-			.Line = m_Line,
-			.Column = m_Column,
-		});
+			.Offset = m_Source.size(),
+		};
 	}
 	std::span<const Token> Lexer::GetTokens() const noexcept {
 		return m_Tokens;
@@ -59,6 +62,9 @@ namespace chit {
 	std::span<const Message> Lexer::GetMessages() const noexcept {
 		return m_Messages;
 	}
+	const LineMap& Lexer::GetLineMap() const noexcept {
+		return m_LineMap;
+	}
 
 	Lexer::Cursor Lexer::NextCursor() {
 		const std::u8string::iterator iterator = m_Current;
@@ -66,16 +72,17 @@ namespace chit {
 
 		return {
 			.Iterator = iterator,
-			.Column = ++m_Column,
 			.Codepoint = codepoint,
 		};
 	}
 	void Lexer::PrevCursor() {
 		utf8::unchecked::prior(m_Current);
-		--m_Column;
+	}
+	std::size_t Lexer::GetOffset(const Cursor& cursor) const noexcept {
+		return static_cast<std::size_t>(cursor.Iterator - m_Source.begin());
 	}
 
-	void Lexer::LexNumber(const Cursor& begin) {
+	Token Lexer::LexNumber(const Cursor& begin) {
 		std::u8string::iterator dataEnd;
 
 		while (m_Current < m_Source.end()) {
@@ -104,48 +111,40 @@ namespace chit {
 			}
 		}
 
-		m_Tokens.push_back({
+		return {
 			.Type = TokenType::DecInteger,
 			.Data = { begin.Iterator, dataEnd },
 			.Suffix = { dataEnd, suffixEnd },
-			.Line = m_Line,
-			.Column = begin.Column,
-		});
+			.Offset = GetOffset(begin),
+		};
 	}
-	void Lexer::LexSpeicalSymbol(const Cursor& begin) {
+	std::optional<Token> Lexer::LexSpeicalSymbol(const Cursor& begin) {
 #define CASE(c, e)														\
 		case c:															\
-			m_Tokens.push_back({										\
+			return Token{												\
 				.Type = TokenType::e,									\
 				.Data = { begin.Iterator, begin.Iterator + 1 },			\
-				.Line = m_Line,											\
-				.Column = begin.Column,									\
-			});															\
-																		\
-			break
+				.Offset = GetOffset(begin),								\
+			}
 
 #define COMPOUND_CASE(c, o)												\
 		case c:															\
-			o															\
-																		\
-			break
+			o
 #define ADD(c, e, o)													\
 		if (m_Current < m_Source.end() && *m_Current == c) {			\
-			m_Tokens.push_back({										\
+			return Token{												\
 				.Type = TokenType::e,									\
 				.Data = { begin.Iterator, ++m_Current },				\
-				.Line = m_Line,											\
-				.Column = begin.Column,									\
-			});															\
+				.Offset = GetOffset(begin),								\
+			};															\
 		} o
 #define END(e)															\
 		else {															\
-			m_Tokens.push_back({										\
+			return Token{												\
 				.Type = TokenType::e,									\
 				.Data = { begin.Iterator, begin.Iterator + 1 },			\
-				.Line = m_Line,											\
-				.Column = begin.Column,									\
-			});															\
+				.Offset = GetOffset(begin),								\
+			};															\
 		}
 
 		switch (begin.Codepoint) {
@@ -177,37 +176,39 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Unrecognized token",
-				.Line = m_Line,
-				.Column = begin.Column,
+				.Offset = GetOffset(begin),
 			});
 
-			break;
+			return std::nullopt;
 		}
 	}
-	void Lexer::LexIdentifier(const Cursor& begin) {
+	Token Lexer::LexIdentifier(const Cursor& begin) {
+		std::u8string::iterator dataEnd = m_Source.end();
+
 		while (m_Current < m_Source.end()) {
 			const auto next = NextCursor();
 			const auto& codepoint = next.Codepoint;
 
 			if (std::isspace(codepoint) || IsSpecialSymbol(codepoint) && codepoint != U'_') {
-				Token token{
-					.Type = TokenType::Identifier,
-					.Data = { begin.Iterator, next.Iterator },
-					.Line = m_Line,
-					.Column = begin.Column,
-				};
-
-				if (const auto keywordIter = KeywordTokens.find(token.Data);
-					keywordIter != KeywordTokens.end()) {
-
-					token.Type = keywordIter->second;
-				}
-	
-				m_Tokens.push_back(std::move(token));
+				dataEnd = next.Iterator;
 
 				PrevCursor();
 				break;
 			}
 		}
+
+		Token token{
+			.Type = TokenType::Identifier,
+			.Data = { begin.Iterator, dataEnd },
+			.Offset = GetOffset(begin),
+		};
+
+		if (const auto keywordIter = KeywordTokens.find(token.Data);
+			keywordIter != KeywordTokens.end()) {
+
+			token.Type = keywordIter->second;
+		}
+
+		return token;
 	}
 }
\ No newline at end of file
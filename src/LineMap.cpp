@@ -0,0 +1,63 @@
+#include <chit/LineMap.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86_FP) && _M_IX86_FP >= 2
+#	include <emmintrin.h>
+#	define CHIT_HAS_SSE2
+#endif
+
+namespace chit {
+	LineMap::LineMap(std::u8string_view source)
+		: m_Source(source) {
+
+		m_LineOffsets.push_back(0);
+
+		const char8_t* const begin = m_Source.data();
+		const char8_t* const end = begin + m_Source.size();
+		const char8_t* current = begin;
+
+#ifdef CHIT_HAS_SSE2
+		const __m128i newlines = _mm_set1_epi8('\n');
+
+		for (; end - current >= 16; current += 16) {
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+			auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newlines)));
+
+			while (mask) {
+				m_LineOffsets.push_back(
+					static_cast<std::size_t>(current - begin) + std::countr_zero(mask) + 1);
+				mask &= mask - 1;
+			}
+		}
+#endif
+
+		for (; current < end; ++current) {
+			if (*current == u8'\n') {
+				m_LineOffsets.push_back(static_cast<std::size_t>(current - begin) + 1);
+			}
+		}
+	}
+
+	Location LineMap::GetLocation(std::size_t offset) const noexcept {
+		assert(!m_LineOffsets.empty());
+		assert(offset <= m_Source.size());
+
+		const auto lineIter = std::upper_bound(m_LineOffsets.begin(), m_LineOffsets.end(), offset) - 1;
+		const auto line = static_cast<std::size_t>(lineIter - m_LineOffsets.begin()) + 1;
+
+		// Column is counted in codepoints, so continuation bytes are skipped
+		std::size_t column = 1;
+
+		for (std::size_t i = *lineIter; i < offset; ++i) {
+			if ((m_Source[i] & 0xC0) != 0x80) {
+				++column;
+			}
+		}
+
+		return { line, column };
+	}
+}
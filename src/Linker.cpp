@@ -1,17 +1,425 @@
 #include <chit/Linker.hpp>
 
+#include <chit/util/String.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace chit {
+	namespace {
+		bool IsLocalOperand(const Instruction& instruction) noexcept {
+			return
+				instruction.IsLabel() || instruction.IsJump() ||
+				instruction.Is(u8"load") || instruction.Is(u8"store") || instruction.Is(u8"lea");
+		}
+
+		std::u8string CreateShortName(std::size_t index) {
+			static constexpr std::u8string_view characters = u8"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+			static constexpr std::size_t leadingCount = 52;		// Names never start with a digit or an underscore
+
+			std::u8string result(1, characters[index % leadingCount]);
+
+			for (index /= leadingCount; index > 0; index /= characters.size()) {
+				--index;
+				result.push_back(characters[index % characters.size()]);
+			}
+
+			return result;
+		}
+
+		void MinifyNames(
+			const Assembly& assembly,
+			std::u8string_view function,
+			std::vector<std::u8string_view>& parameters,
+			std::vector<Instruction>& instructions,
+			const std::unordered_set<std::u8string_view>& functionNames,
+			std::deque<std::u8string>& shortNames,
+			std::u8string& nameMap) {
+
+			// Labels, parameters and locals are all local to a function, so every function counts from the start
+			std::unordered_set<std::u8string_view> mnemonics;
+
+			for (const auto& instruction : instructions) {
+				mnemonics.insert(instruction.Mnemonic);
+			}
+
+			// Short names outlive this function in shortNames, since the linker writes the instructions out later
+			std::unordered_map<std::u8string_view, std::u8string_view> names;
+			std::size_t nextIndex = 0;
+
+			const auto rename = [&](std::u8string_view name) -> std::u8string_view {
+				const auto [entry, isInserted] = names.try_emplace(name);
+
+				if (isInserted) {
+					do {
+						while (shortNames.size() <= nextIndex) {
+							shortNames.push_back(CreateShortName(shortNames.size()));
+						}
+
+						entry->second = shortNames[nextIndex++];
+					} while (functionNames.contains(entry->second) || mnemonics.contains(entry->second));
+
+					// Labels are numbered per function, so the replaced name is the one an unminified build writes
+					nameMap.append(function).append(u8" ").append(entry->second)
+						.append(u8" ").append(name);
+
+					// Locals are followed by the source variables they hold, if any
+					for (std::size_t i = 0; const auto sourceName : assembly.GetSourceNames(function, name)) {
+						nameMap.append(i++ == 0 ? u8" " : u8",").append(sourceName);
+					}
+
+					nameMap.append(u8"\n");
+				}
+
+				return entry->second;
+			};
+
+			for (auto& parameter : parameters) {
+				parameter = rename(parameter);
+			}
+
+			for (auto& instruction : instructions) {
+				if (IsLocalOperand(instruction)) {
+					instruction.Operand = rename(instruction.Operand);
+				}
+			}
+		}
+	}
+
+	namespace {
+		using FunctionList = std::vector<std::pair<const Assembly*, std::u8string_view>>;
+		using Redirections = std::unordered_map<std::u8string_view, std::u8string_view>;
+
+		std::u8string_view Redirect(const Redirections& redirections, std::u8string_view function) {
+			for (auto iter = redirections.find(function); iter != redirections.end(); iter = redirections.find(function)) {
+				function = iter->second;
+			}
+
+			return function;
+		}
+
+		std::u8string NormalizeFunction(const Assembly& assembly, std::u8string_view function, const Redirections& redirections) {
+			// Local names are numbered in order of appearance, so only the shape of the code is compared
+			std::unordered_map<std::u8string_view, std::size_t> names;
+
+			const auto appendName = [&](std::u8string& result, std::u8string_view name) {
+				const auto index = names.try_emplace(name, names.size()).first->second;
+
+				result.append(u8"%").append(ToUtf8String(index));
+			};
+
+			std::u8string result(assembly.HasReturn(function) ? u8"func" : u8"proc");
+
+			for (const auto parameter : assembly.GetParameters(function)) {
+				result.append(u8" ");
+				appendName(result, parameter);
+			}
+
+			result.append(u8"\n");
+
+			for (const auto& instruction : assembly.GetInstructions(function)) {
+				if (instruction.IsLabel()) {
+					appendName(result, instruction.Operand);
+					result.append(u8":");
+				} else {
+					result.append(instruction.Mnemonic).append(u8" ");
+
+					if (IsLocalOperand(instruction)) {
+						appendName(result, instruction.Operand);
+					} else if (instruction.Is(u8"call")) {
+						// A recursive call matches recursive calls in the other copy
+						const auto callee = Redirect(redirections, instruction.Operand);
+
+						result.append(callee == Redirect(redirections, function) ? std::u8string_view(u8"@") : callee);
+					} else {
+						result.append(instruction.Operand);
+					}
+				}
+
+				result.append(u8"\n");
+			}
+
+			return result;
+		}
+
+		Redirections FoldIdenticalFunctions(const FunctionList& functions) {
+			Redirections result;
+
+			// Merging callees can make their callers identical too, so this repeats until nothing changes
+			while (true) {
+				std::unordered_map<std::u8string, std::u8string_view> survivors;
+				const auto oldSize = result.size();
+
+				for (const auto& [assembly, name] : functions) {
+					if (result.contains(name)) continue;
+
+					const auto [survivor, isInserted] = survivors.try_emplace(NormalizeFunction(*assembly, name, result), name);
+					if (isInserted) continue;
+
+					// main is called by the entrypoint, so it always survives
+					if (name == u8"main") {
+						result[survivor->second] = name;
+						survivor->second = name;
+					} else {
+						result[name] = survivor->second;
+					}
+				}
+
+				if (result.size() == oldSize) break;
+			}
+
+			return result;
+		}
+	}
+
+	namespace {
+		struct LinkedFunction final {
+			const chit::Assembly* Assembly;
+			std::u8string_view Name;
+			std::vector<std::u8string_view> Parameters;
+			std::vector<Instruction> Instructions;
+		};
+
+		void RemoveUnreachableFunctions(std::vector<LinkedFunction>& functions) {
+			std::unordered_map<std::u8string_view, std::size_t> indices;
+
+			for (std::size_t i = 0; i < functions.size(); ++i) {
+				indices[functions[i].Name] = i;
+			}
+
+			// Without main, nothing is known about what the entrypoint reaches
+			const auto main = indices.find(u8"main");
+			if (main == indices.end()) return;
+
+			std::vector<bool> isReachable(functions.size());
+			std::vector<std::size_t> worklist{ main->second };
+
+			isReachable[main->second] = true;
+
+			while (!worklist.empty()) {
+				const auto function = worklist.back();
+				worklist.pop_back();
+
+				for (const auto& instruction : functions[function].Instructions) {
+					if (!instruction.Is(u8"call")) continue;
+
+					const auto callee = indices.find(instruction.Operand);
+
+					if (callee != indices.end() && !isReachable[callee->second]) {
+						isReachable[callee->second] = true;
+						worklist.push_back(callee->second);
+					}
+				}
+			}
+
+			std::size_t size = 0;
+
+			for (std::size_t i = 0; i < functions.size(); ++i) {
+				if (isReachable[i]) {
+					if (size != i) {
+						functions[size] = std::move(functions[i]);
+					}
+
+					++size;
+				}
+			}
+
+			functions.erase(functions.begin() + size, functions.end());
+		}
+
+		std::vector<std::size_t> OrderFunctions(const std::vector<LinkedFunction>& functions, const Profile* profile) {
+			std::unordered_map<std::u8string_view, std::size_t> indices;
+
+			for (std::size_t i = 0; i < functions.size(); ++i) {
+				indices[functions[i].Name] = i;
+			}
+
+			// Call sites are weighted by how often the callee runs, if a profile says so
+			const auto getWeight = [profile](std::u8string_view callee) -> std::uint64_t {
+				if (!profile) return 1;
+
+				return std::max<std::uint64_t>(profile->GetCallCount(callee).value_or(1), 1);
+			};
+
+			std::map<std::pair<std::size_t, std::size_t>, std::uint64_t> affinities;
+			std::vector<std::uint64_t> heats(functions.size());
+
+			for (std::size_t caller = 0; caller < functions.size(); ++caller) {
+				for (const auto& instruction : functions[caller].Instructions) {
+					if (!instruction.Is(u8"call")) continue;
+
+					const auto callee = indices.find(instruction.Operand);
+					if (callee == indices.end() || callee->second == caller) continue;
+
+					const auto weight = getWeight(instruction.Operand);
+
+					affinities[std::minmax(caller, callee->second)] += weight;
+					heats[callee->second] += weight;
+				}
+			}
+
+			std::vector<std::pair<std::pair<std::size_t, std::size_t>, std::uint64_t>> edges(affinities.begin(), affinities.end());
+
+			std::stable_sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) {
+				return a.second > b.second;
+			});
+
+			// Pettis-Hansen: chains are joined along the heaviest edges first,
+			// turned so that the two functions of the edge end up next to each other
+			std::vector<std::vector<std::size_t>> chains(functions.size());
+			std::vector<std::size_t> chainIndices(functions.size());
+
+			for (std::size_t i = 0; i < functions.size(); ++i) {
+				chains[i] = { i };
+				chainIndices[i] = i;
+			}
+
+			for (const auto& [edge, weight] : edges) {
+				const auto first = chainIndices[edge.first];
+				const auto second = chainIndices[edge.second];
+				if (first == second) continue;
+
+				auto& firstChain = chains[first];
+				auto& secondChain = chains[second];
+
+				const auto firstPosition = std::find(firstChain.begin(), firstChain.end(), edge.first) - firstChain.begin();
+				const auto secondPosition = std::find(secondChain.begin(), secondChain.end(), edge.second) - secondChain.begin();
+
+				if (static_cast<std::size_t>(firstPosition) < firstChain.size() / 2) {
+					std::reverse(firstChain.begin(), firstChain.end());
+				}
+				if (static_cast<std::size_t>(secondPosition) >= (secondChain.size() + 1) / 2) {
+					std::reverse(secondChain.begin(), secondChain.end());
+				}
+
+				for (const auto function : secondChain) {
+					chainIndices[function] = first;
+				}
+
+				firstChain.insert(firstChain.end(), secondChain.begin(), secondChain.end());
+				secondChain.clear();
+			}
+
+			std::erase_if(chains, [](const auto& chain) {
+				return chain.empty();
+			});
+
+			// Hot chains come first, and with a profile, chains that never ran are moved behind everything else
+			const auto isCold = [&](const std::vector<std::size_t>& chain) {
+				return profile && std::all_of(chain.begin(), chain.end(), [&](std::size_t function) {
+					return profile->GetCallCount(functions[function].Name) == 0;
+				});
+			};
+			const auto getHeat = [&](const std::vector<std::size_t>& chain) {
+				std::uint64_t result = 0;
+
+				for (const auto function : chain) {
+					result = std::max(result, profile ? profile->GetCallCount(functions[function].Name).value_or(0) : heats[function]);
+				}
+
+				return result;
+			};
+
+			std::stable_sort(chains.begin(), chains.end(), [&](const auto& a, const auto& b) {
+				const auto isACold = isCold(a);
+				const auto isBCold = isCold(b);
+				if (isACold != isBCold) return isBCold;
+
+				return getHeat(a) > getHeat(b);
+			});
+
+			std::vector<std::size_t> result;
+
+			for (const auto& chain : chains) {
+				result.insert(result.end(), chain.begin(), chain.end());
+			}
+
+			return result;
+		}
+	}
+
 	void Linker::AddAssembly(const Assembly* assembly) noexcept {
 		m_Assemblies.push_back(assembly);
 	}
+	void Linker::SetProfile(const Profile* profile) noexcept {
+		m_Profile = profile;
+	}
+	void Linker::SetMinifying(bool isMinifying) noexcept {
+		m_IsMinifying = isMinifying;
+	}
+	void Linker::SetLinkTimeOptimizing(bool isLinkTimeOptimizing) noexcept {
+		m_IsLinkTimeOptimizing = isLinkTimeOptimizing;
+	}
 
 	void Linker::Link() noexcept {
 		assert(m_ShitBF.empty());
 
+		FunctionList functions;
+
 		for (const auto& assembly : m_Assemblies) {
-			m_ShitBF.append(assembly->Generate());
+			for (const auto name : assembly->GetFunctionNames()) {
+				functions.push_back({ assembly, name });
+			}
+		}
+
+		// Names are sorted first, so the output never depends on the order of a hash table
+		std::sort(functions.begin(), functions.end(), [](const auto& a, const auto& b) {
+			return a.second < b.second;
+		});
+
+		const auto redirections = FoldIdenticalFunctions(functions);
+		std::vector<LinkedFunction> linkedFunctions;
+
+		for (const auto& [assembly, name] : functions) {
+			if (redirections.contains(name)) continue;
+
+			const auto parameters = assembly->GetParameters(name);
+			const auto instructions = assembly->GetInstructions(name);
+
+			auto& function = linkedFunctions.emplace_back(LinkedFunction{
+				.Assembly = assembly,
+				.Name = name,
+				.Parameters = { parameters.begin(), parameters.end() },
+				.Instructions = { instructions.begin(), instructions.end() },
+			});
+
+			for (auto& instruction : function.Instructions) {
+				if (instruction.Is(u8"call")) {
+					instruction.Operand = Redirect(redirections, instruction.Operand);
+				}
+			}
+		}
+
+		// Every unit is linked here, so a function that main never reaches is dead in the whole program
+		if (m_IsLinkTimeOptimizing) {
+			RemoveUnreachableFunctions(linkedFunctions);
+		}
+
+		std::unordered_set<std::u8string_view> functionNames{ u8"entrypoint", u8"func", u8"proc" };
+
+		for (const auto& [assembly, name] : functions) {
+			functionNames.insert(name);
+		}
+
+		for (const auto index : OrderFunctions(linkedFunctions, m_Profile)) {
+			auto& function = linkedFunctions[index];
+
+			if (m_IsMinifying) {
+				MinifyNames(*function.Assembly, function.Name, function.Parameters, function.Instructions, functionNames, m_ShortNames, m_NameMap);
+			}
+
+			m_ShitBF.append(function.Assembly->GenerateFunction(function.Name, function.Parameters, function.Instructions));
+			m_FrameSizes.append(function.Name).append(u8" ")
+				.append(ToUtf8String(function.Assembly->GetFrameSize(function.Name))).append(u8"\n");
 		}
 
 		m_ShitBF.append(
@@ -21,6 +429,12 @@ namespace chit {
 	std::u8string_view Linker::GetShitBF() const noexcept {
 		return m_ShitBF;
 	}
+	std::u8string_view Linker::GetNameMap() const noexcept {
+		return m_NameMap;
+	}
+	std::u8string_view Linker::GetFrameSizes() const noexcept {
+		return m_FrameSizes;
+	}
 	std::span<const Message> Linker::GetMessages() const noexcept {
 		return m_Messages;
 	}
@@ -1,5 +1,86 @@
+#include <chit/Driver.hpp>
+#include <chit/Server.hpp>
+
 #include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+	std::optional<std::string> ReadFile(const std::string& path) {
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream) return std::nullopt;
+
+		return std::string{
+			std::istreambuf_iterator<char>(stream),
+			std::istreambuf_iterator<char>() };
+	}
+}
 
 int main(int argc, char** argv) {
-	return EXIT_SUCCESS;
+	std::vector<std::string> arguments;
+	std::string serverPath;
+	std::string connectPath;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view argument = argv[i];
+
+		if (argument.starts_with("--server=")) {
+			serverPath = argument.substr(argument.find('=') + 1);
+		} else if (argument.starts_with("--connect=")) {
+			connectPath = argument.substr(argument.find('=') + 1);
+		} else {
+			arguments.push_back(argv[i]);
+		}
+	}
+
+	if (!serverPath.empty())
+		return chit::Server(serverPath).Run() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	const auto options = chit::ParseArguments(arguments);
+	if (!options) {
+		std::cerr << "Usage: " << argv[0] << " [--connect=socket] [-o output] [-fprofile-use=profile] [-flto] [-fminify-names] [-fname-map=map] [-fframe-sizes=report] source...\n";
+		std::cerr << "       " << argv[0] << " --server=socket\n";
+
+		return EXIT_FAILURE;
+	}
+
+	std::optional<chit::DriverResult> result;
+
+	// The client sends the files the server will read, and falls back to compiling by itself when no server answers
+	if (!connectPath.empty()) {
+		std::vector<std::pair<std::string, std::string>> files;
+
+		for (const auto& path : chit::GetReadPaths(*options)) {
+			if (auto contents = ReadFile(path); contents) {
+				files.push_back({ path, std::move(*contents) });
+			}
+		}
+
+		result = chit::RequestCompile(connectPath, arguments, files);
+	}
+	if (!result) {
+		result = chit::RunDriver(*options, ReadFile);
+	}
+
+	std::cout.write(result->Output.data(), result->Output.size());
+	std::cerr.write(result->Errors.data(), result->Errors.size());
+
+	for (const auto& [path, contents] : result->Files) {
+		std::ofstream stream(path, std::ios::binary);
+		if (!stream) {
+			std::cerr << path << ": error: Failed to open file\n";
+
+			return EXIT_FAILURE;
+		}
+
+		stream.write(contents.data(), contents.size());
+	}
+
+	return result->ExitCode;
 }
\ No newline at end of file
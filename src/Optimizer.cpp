@@ -0,0 +1,437 @@
+#include <chit/Optimizer.hpp>
+
+#include <chit/Dataflow.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace chit {
+	namespace {
+		bool IsPureMove(const Instruction& instruction) noexcept {
+			return
+				instruction.Is(u8"push") ||
+				instruction.Is(u8"load") ||
+				instruction.Is(u8"lea") ||
+				instruction.Is(u8"copy");
+		}
+		std::size_t GetPureOperandCount(const Instruction& instruction) noexcept {
+			if (instruction.Is(u8"tol") || instruction.Is(u8"toi")) return 1;
+
+			// Divisions are left alone, since they can trap
+			if (instruction.Is(u8"add") || instruction.Is(u8"sub") ||
+				instruction.Is(u8"mul") || instruction.Is(u8"imul") ||
+				instruction.Is(u8"cmp") || instruction.Is(u8"icmp")) return 2;
+
+			return 0;
+		}
+
+		bool RewriteTail(std::vector<Instruction>& result) {
+			const auto size = result.size();
+			if (size == 0) return false;
+
+			auto& last = result[size - 1];
+
+			// load x, ... load x -> load x, ... copy, as long as only copies of x are in between
+			if (last.Is(u8"load")) {
+				for (std::size_t i = size - 1; i-- > 0;) {
+					if (result[i].Is(u8"load", last.Operand)) {
+						last = { .Mnemonic = u8"copy" };
+
+						return true;
+					} else if (!result[i].Is(u8"copy")) break;
+				}
+			}
+
+			if (size < 2) return false;
+
+			auto& prev = result[size - 2];
+
+			// lea x, tload -> load x
+			if (prev.Is(u8"lea") && last.Is(u8"tload")) {
+				prev.Mnemonic = u8"load";
+				result.pop_back();
+
+				return true;
+			}
+
+			// store x, load x -> copy, store x
+			if (prev.Is(u8"store") && last.Is(u8"load", prev.Operand)) {
+				last = prev;
+				prev = { .Mnemonic = u8"copy" };
+
+				return true;
+			}
+
+			// Truncating right after extending gives back the original value
+			if (prev.Is(u8"tol") && last.Is(u8"toi")) {
+				result.resize(size - 2);
+
+				return true;
+			}
+
+			// A value that is pushed only to be popped
+			if (IsPureMove(prev) && last.Is(u8"pop")) {
+				result.resize(size - 2);
+
+				return true;
+			}
+
+			// An operation whose result is dropped only has to drop its operands, one at a time
+			if (const auto operandCount = GetPureOperandCount(prev); operandCount && last.Is(u8"pop")) {
+				result.resize(size - 2);
+
+				for (std::size_t i = 0; i < operandCount; ++i) {
+					result.push_back({ .Mnemonic = u8"pop" });
+
+					while (RewriteTail(result));
+				}
+
+				return true;
+			}
+
+			if (size < 3) return false;
+
+			// copy, store x, pop -> store x
+			if (result[size - 3].Is(u8"copy") && prev.Is(u8"store") && last.Is(u8"pop")) {
+				result[size - 3] = prev;
+				result.resize(size - 2);
+
+				return true;
+			}
+
+			return false;
+		}
+	}
+
+	namespace {
+		bool EliminateDeadStores(std::vector<Instruction>& instructions) {
+			// Slots whose address is taken may be read through a pointer anywhere
+			std::unordered_set<std::u8string_view> escapedSlots;
+
+			for (const auto& instruction : instructions) {
+				if (instruction.Is(u8"lea")) {
+					escapedSlots.insert(instruction.Operand);
+				}
+			}
+
+			std::unordered_map<std::u8string_view, std::size_t> slots;
+
+			for (const auto& instruction : instructions) {
+				if ((instruction.Is(u8"load") || instruction.Is(u8"store")) && !escapedSlots.contains(instruction.Operand)) {
+					slots.try_emplace(instruction.Operand, slots.size());
+				}
+			}
+
+			if (slots.empty()) return false;
+
+			const auto blocks = FindBasicBlocks(instructions);
+			DataflowProblem liveness{
+				.Direction = DataflowDirection::Backward,
+				.Meet = DataflowMeet::Union,
+				.Size = slots.size(),
+				.Boundary = BitVector(slots.size()),	// Nothing outlives the frame
+			};
+
+			for (const auto& block : blocks) {
+				auto& gen = liveness.Gen.emplace_back(slots.size());
+				auto& kill = liveness.Kill.emplace_back(slots.size());
+
+				for (auto i = block.End; i-- > block.Begin;) {
+					const auto slot = slots.find(instructions[i].Operand);
+					if (instructions[i].IsLabel() || slot == slots.end()) continue;
+
+					if (instructions[i].Is(u8"store")) {
+						gen.Reset(slot->second);
+						kill.Set(slot->second);
+					} else if (instructions[i].Is(u8"load")) {
+						gen.Set(slot->second);
+					}
+				}
+			}
+
+			const auto result = SolveDataflow(blocks, liveness);
+			bool isChanged = false;
+
+			// A store is dead if its slot is overwritten or forgotten on every path before the next load
+			for (std::size_t b = 0; b < blocks.size(); ++b) {
+				auto live = result.Out[b];
+
+				for (auto i = blocks[b].End; i-- > blocks[b].Begin;) {
+					auto& instruction = instructions[i];
+
+					const auto slot = slots.find(instruction.Operand);
+					if (instruction.IsLabel() || slot == slots.end()) continue;
+
+					if (instruction.Is(u8"store")) {
+						if (!live.Test(slot->second)) {
+							instruction = { .Mnemonic = u8"pop" };
+							isChanged = true;
+						}
+
+						live.Reset(slot->second);
+					} else if (instruction.Is(u8"load")) {
+						live.Set(slot->second);
+					}
+				}
+			}
+
+			return isChanged;
+		}
+	}
+
+	namespace {
+		using LabelMap = std::unordered_map<std::u8string_view, std::size_t>;
+
+		LabelMap FindLabels(const std::vector<Instruction>& instructions) {
+			LabelMap result;
+
+			for (std::size_t i = 0; i < instructions.size(); ++i) {
+				if (instructions[i].IsLabel()) {
+					result[instructions[i].Operand] = i;
+				}
+			}
+
+			return result;
+		}
+		std::unordered_map<std::u8string_view, std::size_t> CountJumps(const std::vector<Instruction>& instructions) {
+			std::unordered_map<std::u8string_view, std::size_t> result;
+
+			for (const auto& instruction : instructions) {
+				if (instruction.IsJump()) {
+					++result[instruction.Operand];
+				}
+			}
+
+			return result;
+		}
+		std::size_t SkipLabels(const std::vector<Instruction>& instructions, std::size_t index) noexcept {
+			while (index < instructions.size() && instructions[index].IsLabel()) {
+				++index;
+			}
+
+			return index;
+		}
+
+		bool ThreadJumps(std::vector<Instruction>& instructions) {
+			const auto labels = FindLabels(instructions);
+			bool isChanged = false;
+
+			for (auto& instruction : instructions) {
+				if (!instruction.IsJump()) continue;
+
+				// Follows labels that only lead to another jmp, giving up on cycles
+				std::unordered_set<std::u8string_view> visited{ instruction.Operand };
+				auto target = instruction.Operand;
+
+				while (true) {
+					const auto next = SkipLabels(instructions, labels.at(target) + 1);
+					if (next == instructions.size() || !instructions[next].Is(u8"jmp")) break;
+					if (!visited.insert(instructions[next].Operand).second) break;
+
+					target = instructions[next].Operand;
+				}
+
+				if (target != instruction.Operand) {
+					instruction.Operand = target;
+					isChanged = true;
+				}
+
+				// A jmp to a ret is a ret
+				if (const auto next = SkipLabels(instructions, labels.at(instruction.Operand) + 1);
+					instruction.Is(u8"jmp") && next < instructions.size() && instructions[next].Is(u8"ret")) {
+
+					instruction = { .Mnemonic = u8"ret" };
+					isChanged = true;
+				}
+			}
+
+			return isChanged;
+		}
+		bool RemoveJumpsToNext(std::vector<Instruction>& instructions) {
+			bool isChanged = false;
+
+			for (std::size_t i = 0; i < instructions.size(); ++i) {
+				if (!instructions[i].Is(u8"jmp")) continue;
+
+				for (std::size_t j = i + 1; j < instructions.size() && instructions[j].IsLabel(); ++j) {
+					if (instructions[j].Operand == instructions[i].Operand) {
+						instructions.erase(instructions.begin() + i--);
+						isChanged = true;
+
+						break;
+					}
+				}
+			}
+
+			return isChanged;
+		}
+		bool RemoveUnreachable(std::vector<Instruction>& instructions) {
+			const auto labels = FindLabels(instructions);
+
+			std::vector<bool> isReachable(instructions.size());
+			std::vector<std::size_t> worklist{ 0 };
+
+			while (!worklist.empty()) {
+				auto i = worklist.back();
+				worklist.pop_back();
+
+				for (; i < instructions.size() && !isReachable[i]; ++i) {
+					isReachable[i] = true;
+
+					if (instructions[i].IsJump()) {
+						worklist.push_back(labels.at(instructions[i].Operand));
+					}
+					if (instructions[i].IsTerminator()) break;
+				}
+			}
+
+			const auto jumps = CountJumps(instructions);
+			const auto oldSize = instructions.size();
+			std::size_t size = 0;
+
+			// Labels nothing jumps to only split blocks
+			for (std::size_t i = 0; i < oldSize; ++i) {
+				const auto isKept =
+					isReachable[i] &&
+					!(instructions[i].IsLabel() && !jumps.contains(instructions[i].Operand));
+
+				if (isKept) {
+					instructions[size++] = instructions[i];
+				}
+			}
+
+			instructions.resize(size);
+
+			return size != oldSize;
+		}
+		bool MergeBlocks(std::vector<Instruction>& instructions) {
+			const auto labels = FindLabels(instructions);
+			const auto jumps = CountJumps(instructions);
+
+			for (std::size_t i = 0; i < instructions.size(); ++i) {
+				if (!instructions[i].Is(u8"jmp") || jumps.at(instructions[i].Operand) != 1) continue;
+
+				// The target block can be moved if nothing falls into it and it never falls out
+				const auto begin = labels.at(instructions[i].Operand);
+				if (begin == 0 || !instructions[begin - 1].IsTerminator()) continue;
+
+				auto end = begin;
+				while (end < instructions.size() && !instructions[end].IsTerminator()) {
+					++end;
+				}
+
+				if (end == instructions.size() || (begin <= i && i <= end)) continue;
+
+				std::vector<Instruction> block(instructions.begin() + begin + 1, instructions.begin() + end + 1);
+
+				if (begin < i) {
+					instructions.erase(instructions.begin() + i);
+					instructions.insert(instructions.begin() + i, block.begin(), block.end());
+					instructions.erase(instructions.begin() + begin, instructions.begin() + end + 1);
+				} else {
+					instructions.erase(instructions.begin() + begin, instructions.begin() + end + 1);
+					instructions.erase(instructions.begin() + i);
+					instructions.insert(instructions.begin() + i, block.begin(), block.end());
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+		bool MergeTails(std::vector<Instruction>& instructions, const LabelCreator& createLabel) {
+			std::vector<std::size_t> terminators;
+
+			for (std::size_t i = 0; i < instructions.size(); ++i) {
+				if (instructions[i].IsTerminator()) {
+					terminators.push_back(i);
+				}
+			}
+
+			for (std::size_t a = 0; a < terminators.size(); ++a) {
+				for (std::size_t b = a + 1; b < terminators.size(); ++b) {
+					const auto first = terminators[a];
+					const auto second = terminators[b];
+
+					// Nothing can jump into the middle of a tail, because it contains no label
+					std::size_t length = 0;
+
+					while (length <= first && second - length > first) {
+						const auto& firstInstruction = instructions[first - length];
+						const auto& secondInstruction = instructions[second - length];
+
+						if (firstInstruction.IsLabel() || secondInstruction.IsLabel() ||
+							!firstInstruction.Is(secondInstruction.Mnemonic, secondInstruction.Operand)) break;
+
+						++length;
+					}
+
+					// Replacing a tail with a jmp only pays off for two instructions or more.
+					// The kept tail is either fallen into or already jumped to, so MergeBlocks never moves it back
+					if (length < 2) continue;
+
+					const auto tailBegin = second - length + 1;
+					std::u8string_view label;
+
+					if (instructions[tailBegin - 1].IsLabel()) {
+						label = instructions[tailBegin - 1].Operand;
+					} else {
+						label = createLabel();
+						instructions.insert(instructions.begin() + tailBegin, { .Operand = label });
+					}
+
+					instructions.erase(instructions.begin() + (first - length + 1), instructions.begin() + first + 1);
+					instructions.insert(instructions.begin() + (first - length + 1), {
+						.Mnemonic = u8"jmp",
+						.Operand = label,
+					});
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	void SimplifyControlFlow(std::vector<Instruction>& instructions, const LabelCreator& createLabel) {
+		if (instructions.empty()) return;
+
+		while (true) {
+			bool isChanged = ThreadJumps(instructions);
+
+			isChanged |= RemoveJumpsToNext(instructions);
+			isChanged |= RemoveUnreachable(instructions);
+			isChanged |= MergeBlocks(instructions);
+
+			if (!isChanged && !MergeTails(instructions, createLabel)) break;
+		}
+	}
+
+	void ScheduleStack(std::vector<Instruction>& instructions) {
+		// Values are kept on the operand stack instead of being reloaded from their slots.
+		// Rewrites only look at adjacent instructions, so they never cross a label or a jump
+		while (true) {
+			std::vector<Instruction> result;
+			result.reserve(instructions.size());
+
+			for (const auto& instruction : instructions) {
+				result.push_back(instruction);
+
+				while (RewriteTail(result));
+			}
+
+			const bool isShrunk = result.size() != instructions.size();
+
+			instructions = std::move(result);
+
+			// Removed loads can make more stores dead, and dead stores leave pops behind to rewrite
+			if (!EliminateDeadStores(instructions) && !isShrunk) break;
+		}
+	}
+}
\ No newline at end of file
@@ -8,26 +8,31 @@
 #include <chit/ast/Type.hpp>
 
 #include <cassert>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
-#include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 
 namespace chit {
 	Parser::Parser(std::span<const Token> tokens) noexcept
 		: m_Tokens(tokens) {
-		m_Current = m_Tokens.begin();
+
+		assert(!m_Tokens.empty());
+		assert(m_Tokens.back().Type == TokenType::Eof);
 	}
+	Parser::Parser(Lexer& lexer) noexcept
+		: m_Lexer(&lexer) {}
 
 	void Parser::Parse() {
-		assert(m_Current == m_Tokens.begin());
+		assert(m_Current == 0);
 		assert(m_RootContext == nullptr);
 		assert(m_RootNode == nullptr);
 
 		m_RootNode = std::make_unique<RootNode>();
 
-		while (m_Current < m_Tokens.end()) {
+		while (CurrentToken().Type != TokenType::Eof) {
 			if (auto statement = ParseStatement(); statement) {
 				m_RootNode->Statements.push_back(std::move(statement));
 			} else {
@@ -48,12 +53,37 @@ namespace chit {
 		return m_Messages;
 	}
 
-	const Token* Parser::AcceptToken(TokenType tokenType) noexcept {
-		if (m_Current->Type == tokenType) return &*m_Current++;
-		else return nullptr;
+	const Token& Parser::GetToken(std::size_t index) {
+		if (!m_Lexer) {
+			assert(index < m_Tokens.size());
+
+			return m_Tokens[index];
+		}
+
+		assert(index + TokenBufferSize >= m_LexedTokenCount);
+
+		while (m_LexedTokenCount <= index) {
+			m_TokenBuffer[m_LexedTokenCount++ % TokenBufferSize] = m_Lexer->NextToken();
+		}
+
+		return m_TokenBuffer[index % TokenBufferSize];
 	}
-	const Token& Parser::PrevToken() const noexcept {
-		return *(m_Current - 1);
+	const Token& Parser::CurrentToken() {
+		return GetToken(m_Current);
+	}
+	const Token& Parser::PrevToken() {
+		assert(m_Current > 0);
+
+		return GetToken(m_Current - 1);
+	}
+	std::optional<Token> Parser::AcceptToken(TokenType tokenType) {
+		if (const auto& token = CurrentToken(); token.Type == tokenType) {
+			++m_Current;
+
+			return token;
+		} else {
+			return std::nullopt;
+		}
 	}
 
 #define ACCEPT(n, t) const auto n = AcceptToken(t); n
@@ -70,12 +100,13 @@ namespace chit {
 		std::vector<std::u8string_view> names;
 
 		while (true) {
-			switch (m_Current->Type) {
+			switch (CurrentToken().Type) {
 			case TokenType::Int:
 			case TokenType::Long:
 			case TokenType::Signed:
 			case TokenType::Unsigned:
-				names.push_back((m_Current++)->Data);
+				names.push_back(CurrentToken().Data);
+				++m_Current;
 
 				break;
 
@@ -232,8 +263,7 @@ namespace chit {
 					m_Messages.push_back({
 						.Type = MessageType::Error,
 						.Data = u8"Expected ','",
-						.Line = m_Current->Line,
-						.Column = m_Current->Column,
+						.Offset = CurrentToken().Offset,
 					});
 
 					return nullptr;
@@ -254,14 +284,14 @@ namespace chit {
 		if (ACCEPT(nameToken, TokenType::Identifier)) {
 			return std::unique_ptr<ExpressionNode>(new IdentifierNode(nameToken->Data));
 		} else if (ACCEPT(integerToken, TokenType::DecInteger)) {
-			return ParseInteger(integerToken);
+			return ParseInteger(*integerToken);
 		} else {
 			return nullptr;
 		}
 	}
 
 	std::unique_ptr<ExpressionNode> Parser::ParseInteger(
-		const Token* integerToken) {
+		const Token& integerToken) {
 
 		bool isUnsigned = false, isLong = false, isLongLong = false;
 
@@ -271,15 +301,16 @@ namespace chit {
 		unsigned long long value;
 		TypePtr type;
 
-		try {
-			value = std::stoull(std::string(
-				integerToken->Data.begin(), integerToken->Data.end()));
-		} catch (...) {
+		const auto dataBegin = reinterpret_cast<const char*>(integerToken.Data.data());
+		const auto dataEnd = dataBegin + integerToken.Data.size();
+
+		if (const auto [ptr, ec] = std::from_chars(dataBegin, dataEnd, value);
+			ec != std::errc{} || ptr != dataEnd) {
+
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Too large integer constant",
-				.Line = integerToken->Line,
-				.Column = integerToken->Column,
+				.Offset = integerToken.Offset,
 			});
 
 			return nullptr;
@@ -355,27 +386,25 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Too large integer constant",
-				.Line = integerToken->Line,
-				.Column = integerToken->Column,
+				.Offset = integerToken.Offset,
 			});
 
 			return nullptr;
 		}
 	}
 	bool Parser::ParseIntegerSuffix(
-		const Token* integerToken,
+		const Token& integerToken,
 		bool& isUnsigned, bool& isLong, bool& isLongLong) {
 
-		for (std::size_t i = 0; i < integerToken->Suffix.size(); ++i) {
-			if (integerToken->Suffix[i] == u8'u' ||
-				integerToken->Suffix[i] == u8'U') {
+		for (std::size_t i = 0; i < integerToken.Suffix.size(); ++i) {
+			if (integerToken.Suffix[i] == u8'u' ||
+				integerToken.Suffix[i] == u8'U') {
 
 				if (isUnsigned) {
 					m_Messages.push_back({
 						.Type = MessageType::Error,
 						.Data = u8"Duplicated unsigned-suffix",
-						.Line = integerToken->Line,
-						.Column = integerToken->Column,
+						.Offset = integerToken.Offset,
 					});
 
 					return false;
@@ -383,20 +412,19 @@ namespace chit {
 					isUnsigned = true;
 				}
 			} else if (
-				integerToken->Suffix[i] == u8'l' ||
-				integerToken->Suffix[i] == u8'L') {
+				integerToken.Suffix[i] == u8'l' ||
+				integerToken.Suffix[i] == u8'L') {
 
 				if (isLong || isLongLong) {
 					m_Messages.push_back({
 						.Type = MessageType::Error,
 						.Data = u8"Duplicated long-suffix",
-						.Line = integerToken->Line,
-						.Column = integerToken->Column,
+						.Offset = integerToken.Offset,
 					});
 
 					return false;
-				} else if (i + 1 != integerToken->Suffix.size() &&
-					integerToken->Suffix[i + 1] == integerToken->Suffix[i]) {
+				} else if (i + 1 != integerToken.Suffix.size() &&
+					integerToken.Suffix[i + 1] == integerToken.Suffix[i]) {
 
 					isLongLong = true;
 					++i;
@@ -407,8 +435,7 @@ namespace chit {
 				m_Messages.push_back({
 					.Type = MessageType::Error,
 					.Data = u8"Invalid suffix",
-					.Line = integerToken->Line,
-					.Column = integerToken->Column,
+					.Offset = integerToken.Offset,
 				});
 
 				return false;
@@ -431,25 +458,23 @@ namespace chit {
 				m_Messages.push_back({
 					.Type = MessageType::Error,
 					.Data = u8"Expected identifier",
-					.Line = m_Current->Line,
-					.Column = m_Current->Column,
+					.Offset = CurrentToken().Offset,
 				});
 
 				return nullptr;
 			}
 
 			if (AcceptToken(TokenType::LeftParenthesis)) {
-				return ParseFunctionDeclaration(std::move(typeNode), nameToken);
+				return ParseFunctionDeclaration(std::move(typeNode), *nameToken);
 			} else {
-				return ParseVariableDeclaration(std::move(typeNode), nameToken);
+				return ParseVariableDeclaration(std::move(typeNode), *nameToken);
 			}
 		} else if (auto exprNode = ParseExpression(); exprNode) {
 			if (!AcceptToken(TokenType::Semicolon)) {
 				m_Messages.push_back({
 					.Type = MessageType::Error,
 					.Data = u8"Expected ';'",
-					.Line = m_Current->Line,
-					.Column = m_Current->Column,
+					.Offset = CurrentToken().Offset,
 				});
 
 				return nullptr;
@@ -468,8 +493,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected expression",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -479,8 +503,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected ';'",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -495,8 +518,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected '('",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -507,8 +529,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected expression",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -518,8 +539,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected ')'",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -530,8 +550,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected statement",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -551,8 +570,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected statement",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return std::unique_ptr<StatementNode>(new IfNode(
@@ -564,7 +582,7 @@ namespace chit {
 	}
 	std::unique_ptr<StatementNode> Parser::ParseFunctionDeclaration(
 		std::unique_ptr<TypeNode> returnTypeNode,
-		const Token* nameToken) {
+		const Token& nameToken) {
 
 		std::vector<std::pair<
 			std::u8string_view,
@@ -575,8 +593,7 @@ namespace chit {
 				m_Messages.push_back({
 					.Type = MessageType::Error,
 					.Data = u8"Expected ','",
-					.Line = m_Current->Line,
-					.Column = m_Current->Column,
+					.Offset = CurrentToken().Offset,
 				});
 
 				return nullptr;
@@ -587,8 +604,7 @@ namespace chit {
 				m_Messages.push_back({
 					.Type = MessageType::Error,
 					.Data = u8"Expected type",
-					.Line = m_Current->Line,
-					.Column = m_Current->Column,
+					.Offset = CurrentToken().Offset,
 				});
 
 				return nullptr;
@@ -603,7 +619,8 @@ namespace chit {
 
 		std::unique_ptr<FunctionDeclarationNode> funcDeclNode(new FunctionDeclarationNode(
 			std::move(returnTypeNode),
-			nameToken->Data,
+			nameToken.Data,
+			nameToken.Offset,
 			std::move(parameters)
 		));
 
@@ -622,8 +639,7 @@ namespace chit {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected ';'",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -631,19 +647,19 @@ namespace chit {
 	}
 	std::unique_ptr<StatementNode> Parser::ParseVariableDeclaration(
 		std::unique_ptr<TypeNode> typeNode,
-		const Token* nameToken) {
+		const Token& nameToken) {
 
 		if (AcceptToken(TokenType::Semicolon)) {
 			return std::unique_ptr<StatementNode>(new VariableDeclarationNode(
 				std::move(typeNode),
-				nameToken->Data
+				nameToken.Data,
+				nameToken.Offset
 			));
 		} else if (!AcceptToken(TokenType::Assignment)) {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected ';'",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -652,8 +668,7 @@ namespace chit {
 				m_Messages.push_back({
 					.Type = MessageType::Error,
 					.Data = u8"Expected ';'",
-					.Line = m_Current->Line,
-					.Column = m_Current->Column,
+					.Offset = CurrentToken().Offset,
 				});
 
 				return nullptr;
@@ -661,15 +676,15 @@ namespace chit {
 
 			return std::unique_ptr<StatementNode>(new VariableDeclarationNode(
 				std::move(typeNode),
-				nameToken->Data,
+				nameToken.Data,
+				nameToken.Offset,
 				std::move(exprNode)
 			));
 		} else {
 			m_Messages.push_back({
 				.Type = MessageType::Error,
 				.Data = u8"Expected expression",
-				.Line = m_Current->Line,
-				.Column = m_Current->Column,
+				.Offset = CurrentToken().Offset,
 			});
 
 			return nullptr;
@@ -0,0 +1,98 @@
+#include <chit/Profile.hpp>
+
+#include <algorithm>
+#include <charconv>
+
+namespace chit {
+	namespace {
+		std::u8string_view ReadField(std::u8string_view& line) noexcept {
+			const auto begin = line.find_first_not_of(u8" \t\r");
+			if (begin == std::u8string_view::npos) {
+				line = {};
+
+				return {};
+			}
+
+			line.remove_prefix(begin);
+
+			const auto end = std::min(line.find_first_of(u8" \t\r"), line.size());
+			const auto field = line.substr(0, end);
+
+			line.remove_prefix(end);
+
+			return field;
+		}
+		template<typename T>
+		bool ReadInteger(std::u8string_view& line, T& value) noexcept {
+			const auto field = ReadField(line);
+			const auto dataBegin = reinterpret_cast<const char*>(field.data());
+			const auto dataEnd = dataBegin + field.size();
+
+			const auto [ptr, ec] = std::from_chars(dataBegin, dataEnd, value);
+
+			return !field.empty() && ec == std::errc{} && ptr == dataEnd;
+		}
+	}
+
+	bool Profile::Parse(std::u8string_view text) {
+		// Each line is either "call <function> <count>" or "branch <function> <index> <then count> <else count>"
+		while (!text.empty()) {
+			const auto lineEnd = std::min(text.find(u8'\n'), text.size());
+			auto line = text.substr(0, lineEnd);
+
+			text.remove_prefix(std::min(lineEnd + 1, text.size()));
+
+			const auto kind = ReadField(line);
+			if (kind.empty() || kind.starts_with(u8'#')) continue;
+
+			const auto name = ReadField(line);
+			if (name.empty()) return false;
+
+			auto& function = m_Functions[std::u8string(name)];
+
+			if (kind == u8"call") {
+				std::uint64_t callCount;
+
+				if (!ReadInteger(line, callCount)) return false;
+
+				function.CallCount = callCount;
+				m_MaxCallCount = std::max(m_MaxCallCount, callCount);
+			} else if (kind == u8"branch") {
+				std::size_t index;
+				BranchCount count;
+
+				if (!ReadInteger(line, index) ||
+					!ReadInteger(line, count.Then) ||
+					!ReadInteger(line, count.Else)) return false;
+
+				function.Branches[index] = count;
+			} else return false;
+
+			if (!ReadField(line).empty()) return false;
+		}
+
+		return true;
+	}
+
+	std::optional<std::uint64_t> Profile::GetCallCount(std::u8string_view function) const {
+		if (const auto functionIter = m_Functions.find(std::u8string(function));
+			functionIter != m_Functions.end()) {
+
+			return functionIter->second.CallCount;
+		} else return std::nullopt;
+	}
+	std::optional<BranchCount> Profile::GetBranchCount(std::u8string_view function, std::size_t branch) const {
+		const auto functionIter = m_Functions.find(std::u8string(function));
+		if (functionIter == m_Functions.end()) return std::nullopt;
+
+		const auto& branches = functionIter->second.Branches;
+
+		if (const auto branchIter = branches.find(branch); branchIter != branches.end()) return branchIter->second;
+		else return std::nullopt;
+	}
+	bool Profile::IsHot(std::u8string_view function) const {
+		const auto callCount = GetCallCount(function);
+
+		return callCount && *callCount && *callCount * HotRatio >= m_MaxCallCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <chit/Range.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+
+namespace chit {
+	namespace {
+		constexpr auto Int64Min = std::numeric_limits<std::int64_t>::min();
+		constexpr auto Int64Max = std::numeric_limits<std::int64_t>::max();
+
+		std::optional<std::int64_t> CheckedAdd(std::int64_t a, std::int64_t b) noexcept {
+			if ((b > 0 && a > Int64Max - b) || (b < 0 && a < Int64Min - b)) return std::nullopt;
+			else return a + b;
+		}
+		std::optional<std::int64_t> CheckedSubtract(std::int64_t a, std::int64_t b) noexcept {
+			if ((b < 0 && a > Int64Max + b) || (b > 0 && a < Int64Min + b)) return std::nullopt;
+			else return a - b;
+		}
+		std::optional<std::int64_t> CheckedMultiply(std::int64_t a, std::int64_t b) noexcept {
+			if (a == 0 || b == 0) return 0;
+			if ((a == -1 && b == Int64Min) || (b == -1 && a == Int64Min)) return std::nullopt;
+
+			const auto result = static_cast<std::int64_t>(static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b));
+			if (result / b != a) return std::nullopt;
+			else return result;
+		}
+		std::optional<std::int64_t> CheckedDivide(std::int64_t a, std::int64_t b) noexcept {
+			assert(b != 0);
+
+			if (a == Int64Min && b == -1) return std::nullopt;
+			else return a / b;
+		}
+
+		template<typename F>
+		std::optional<Range> EvaluateCorners(const Range& left, const Range& right, F&& operation) noexcept {
+			std::optional<Range> result;
+
+			// The operation is monotonic in each operand over these intervals, so the extremes are at the corners
+			for (const auto a : { left.Min, left.Max }) {
+				for (const auto b : { right.Min, right.Max }) {
+					const auto value = operation(a, b);
+					if (!value) return std::nullopt;
+
+					if (result) {
+						result->Min = std::min(result->Min, *value);
+						result->Max = std::max(result->Max, *value);
+					} else {
+						result = Range{ .Min = *value, .Max = *value };
+					}
+				}
+			}
+
+			return result;
+		}
+	}
+
+	bool Range::IsIn(const Range& other) const noexcept {
+		return other.Min <= Min && Max <= other.Max;
+	}
+	bool Range::IsPoint() const noexcept {
+		return Min == Max;
+	}
+
+	std::optional<Range> Range::GetTypeRange(const TypePtr& type) noexcept {
+		const auto builtinType = IsBuiltinType(type);
+
+		assert(builtinType);
+		assert(builtinType->Rank);
+
+		switch (builtinType->Size) {
+		case 4:
+			if (builtinType->IsUnsigned()) {
+				return Range{ .Min = 0, .Max = std::numeric_limits<std::uint32_t>::max() };
+			} else {
+				return Range{ .Min = std::numeric_limits<std::int32_t>::min(), .Max = std::numeric_limits<std::int32_t>::max() };
+			}
+
+		case 8:
+			// Every unsigned 64-bit value cannot be represented
+			if (builtinType->IsUnsigned()) return std::nullopt;
+			else return Range{ .Min = Int64Min, .Max = Int64Max };
+
+		default:
+			assert(false);
+
+			return std::nullopt;
+		}
+	}
+	bool Range::IsIn(const std::optional<Range>& range, const TypePtr& type) noexcept {
+		if (!range) return false;
+
+		if (const auto typeRange = GetTypeRange(type); typeRange) return range->IsIn(*typeRange);
+		else return range->Min >= 0;
+	}
+	std::optional<Range> Range::Convert(const std::optional<Range>& range, const TypePtr& type) noexcept {
+		// A value that does not fit wraps around to anywhere in the type
+		if (IsIn(range, type)) return range;
+		else return GetTypeRange(type);
+	}
+	std::optional<Range> Range::Evaluate(TokenType operator_, const Range& left, const Range& right) noexcept {
+		switch (operator_) {
+		case TokenType::Addition:
+			return EvaluateCorners(left, right, CheckedAdd);
+		case TokenType::Subtraction:
+			return EvaluateCorners(left, right, CheckedSubtract);
+		case TokenType::Multiplication:
+			return EvaluateCorners(left, right, CheckedMultiply);
+
+		case TokenType::Division:
+			if (right.Min <= 0 && right.Max >= 0) return std::nullopt;
+			else return EvaluateCorners(left, right, CheckedDivide);
+
+		case TokenType::Modulo: {
+			if (right.Min <= 0 && right.Max >= 0) return std::nullopt;
+			if (right.Min == Int64Min) return std::nullopt;
+
+			// The remainder is smaller than the divisor and takes the sign of the dividend
+			const auto bound = std::max(std::abs(right.Min), std::abs(right.Max)) - 1;
+
+			return Range{
+				.Min = left.Min >= 0 ? 0 : std::max(left.Min, -bound),
+				.Max = left.Max <= 0 ? 0 : std::min(left.Max, bound),
+			};
+		}
+
+		case TokenType::Equivalence:
+			if (left.IsPoint() && right.IsPoint() && left.Min == right.Min) return Range{ .Min = 1, .Max = 1 };
+			else if (left.Max < right.Min || right.Max < left.Min) return Range{ .Min = 0, .Max = 0 };
+			else return Range{ .Min = 0, .Max = 1 };
+
+		case TokenType::GreaterThan:
+			return Evaluate(TokenType::LessThan, right, left);
+		case TokenType::LessThan:
+			if (left.Max < right.Min) return Range{ .Min = 1, .Max = 1 };
+			else if (left.Min >= right.Max) return Range{ .Min = 0, .Max = 0 };
+			else return Range{ .Min = 0, .Max = 1 };
+
+		case TokenType::GreaterThanOrEqual:
+			return Evaluate(TokenType::LessThanOrEqual, right, left);
+		case TokenType::LessThanOrEqual:
+			if (left.Max <= right.Min) return Range{ .Min = 1, .Max = 1 };
+			else if (left.Min > right.Max) return Range{ .Min = 0, .Max = 0 };
+			else return Range{ .Min = 0, .Max = 1 };
+
+		default:
+			return std::nullopt;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,323 @@
+#include <chit/Server.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+#ifndef _WIN32
+#	include <sys/socket.h>
+#	include <sys/time.h>
+#	include <sys/un.h>
+#	include <unistd.h>
+#endif
+
+namespace chit {
+	namespace {
+		// Every message is its size followed by its contents, and sizes are 8 bytes in little endian
+		constexpr std::uint64_t MaxMessageSize = std::uint64_t{ 1 } << 30;
+
+		void WriteSize(std::string& buffer, std::uint64_t size) {
+			for (int i = 0; i < 8; ++i) {
+				buffer.push_back(static_cast<char>((size >> (i * 8)) & 0xFF));
+			}
+		}
+		void WriteString(std::string& buffer, std::string_view string) {
+			WriteSize(buffer, string.size());
+			buffer.append(string);
+		}
+
+		class MessageReader final {
+		private:
+			std::string_view m_Data;
+
+		public:
+			explicit MessageReader(std::string_view data) noexcept
+				: m_Data(data) {}
+
+		public:
+			bool ReadSize(std::uint64_t& size) noexcept {
+				if (m_Data.size() < 8) return false;
+
+				size = 0;
+
+				for (int i = 0; i < 8; ++i) {
+					size |= static_cast<std::uint64_t>(static_cast<unsigned char>(m_Data[i])) << (i * 8);
+				}
+
+				m_Data.remove_prefix(8);
+
+				return true;
+			}
+			bool ReadString(std::string& string) {
+				std::uint64_t size;
+				if (!ReadSize(size) || size > m_Data.size()) return false;
+
+				string = m_Data.substr(0, size);
+				m_Data.remove_prefix(size);
+
+				return true;
+			}
+			bool ReadPairs(std::vector<std::pair<std::string, std::string>>& pairs) {
+				std::uint64_t count;
+				if (!ReadSize(count) || count > m_Data.size() / 16) return false;
+
+				pairs.resize(count);
+
+				for (auto& [first, second] : pairs) {
+					if (!ReadString(first) || !ReadString(second)) return false;
+				}
+
+				return true;
+			}
+			bool IsEnd() const noexcept {
+				return m_Data.empty();
+			}
+		};
+
+		std::string EncodeRequest(const std::vector<std::string>& arguments, const std::vector<std::pair<std::string, std::string>>& files) {
+			std::string result;
+
+			WriteSize(result, arguments.size());
+			for (const auto& argument : arguments) {
+				WriteString(result, argument);
+			}
+
+			WriteSize(result, files.size());
+			for (const auto& [path, contents] : files) {
+				WriteString(result, path);
+				WriteString(result, contents);
+			}
+
+			return result;
+		}
+		std::string EncodeResponse(const DriverResult& response) {
+			std::string result;
+
+			WriteSize(result, static_cast<std::uint64_t>(static_cast<std::int64_t>(response.ExitCode)));
+			WriteString(result, response.Output);
+			WriteString(result, response.Errors);
+
+			WriteSize(result, response.Files.size());
+			for (const auto& [path, contents] : response.Files) {
+				WriteString(result, path);
+				WriteString(result, contents);
+			}
+
+			return result;
+		}
+		std::optional<DriverResult> DecodeResponse(std::string_view response) {
+			MessageReader reader(response);
+			DriverResult result;
+			std::uint64_t exitCode;
+
+			if (!reader.ReadSize(exitCode) ||
+				!reader.ReadString(result.Output) ||
+				!reader.ReadString(result.Errors) ||
+				!reader.ReadPairs(result.Files) ||
+				!reader.IsEnd()) return std::nullopt;
+
+			result.ExitCode = static_cast<int>(static_cast<std::int64_t>(exitCode));
+
+			return result;
+		}
+
+#ifndef _WIN32
+		class Socket final {
+		private:
+			int m_Descriptor = -1;
+
+		public:
+			explicit Socket(int descriptor) noexcept
+				: m_Descriptor(descriptor) {}
+			Socket(const Socket&) = delete;
+			~Socket() {
+				if (m_Descriptor != -1) {
+					close(m_Descriptor);
+				}
+			}
+
+		public:
+			Socket& operator=(const Socket&) = delete;
+
+		public:
+			int Get() const noexcept {
+				return m_Descriptor;
+			}
+
+			bool Send(std::string_view message) const {
+				std::string buffer;
+
+				WriteString(buffer, message);
+
+				for (std::size_t offset = 0; offset < buffer.size();) {
+					const auto sent = send(m_Descriptor, buffer.data() + offset, buffer.size() - offset, MSG_NOSIGNAL);
+					if (sent <= 0) return false;
+
+					offset += static_cast<std::size_t>(sent);
+				}
+
+				return true;
+			}
+			std::optional<std::string> Receive() const {
+				std::string header(8, '\0');
+				if (!ReceiveAll(header.data(), header.size())) return std::nullopt;
+
+				std::uint64_t size;
+				if (!MessageReader(header).ReadSize(size) || size > MaxMessageSize) return std::nullopt;
+
+				std::string result(size, '\0');
+				if (!ReceiveAll(result.data(), result.size())) return std::nullopt;
+
+				return result;
+			}
+
+		private:
+			bool ReceiveAll(char* data, std::size_t size) const {
+				for (std::size_t offset = 0; offset < size;) {
+					const auto received = recv(m_Descriptor, data + offset, size - offset, 0);
+					if (received <= 0) return false;
+
+					offset += static_cast<std::size_t>(received);
+				}
+
+				return true;
+			}
+		};
+
+		std::optional<sockaddr_un> MakeAddress(const std::string& socketPath) {
+			sockaddr_un result{};
+
+			if (socketPath.size() >= sizeof(result.sun_path)) return std::nullopt;
+
+			result.sun_family = AF_UNIX;
+			std::memcpy(result.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+			return result;
+		}
+#endif
+	}
+}
+
+namespace chit {
+	Server::Server(std::string socketPath)
+		: m_SocketPath(std::move(socketPath)) {}
+
+	bool Server::Run() {
+#ifdef _WIN32
+		std::cerr << m_SocketPath << ": error: Compile servers need Unix sockets\n";
+
+		return false;
+#else
+		const auto address = MakeAddress(m_SocketPath);
+		if (!address) {
+			std::cerr << m_SocketPath << ": error: Socket path is too long\n";
+
+			return false;
+		}
+
+		// A socket left behind by a server that did not shut down cleanly would block bind, but a live one is kept
+		if (const Socket probe(socket(AF_UNIX, SOCK_STREAM, 0));
+			probe.Get() != -1 && connect(probe.Get(), reinterpret_cast<const sockaddr*>(&*address), sizeof(*address)) == 0) {
+			std::cerr << m_SocketPath << ": error: Another server is listening\n";
+
+			return false;
+		}
+
+		unlink(m_SocketPath.c_str());
+
+		const Socket listener(socket(AF_UNIX, SOCK_STREAM, 0));
+
+		if (listener.Get() == -1 ||
+			bind(listener.Get(), reinterpret_cast<const sockaddr*>(&*address), sizeof(*address)) == -1 ||
+			listen(listener.Get(), SOMAXCONN) == -1) {
+			std::cerr << m_SocketPath << ": error: " << std::strerror(errno) << '\n';
+
+			return false;
+		}
+
+		// Requests are served one at a time, so results and the state of the process stay warm between them
+		while (true) {
+			const Socket client(accept(listener.Get(), nullptr, nullptr));
+			if (client.Get() == -1) continue;
+
+			const timeval timeout{ .tv_sec = TimeoutSeconds };
+
+			if (setsockopt(client.Get(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == -1 ||
+				setsockopt(client.Get(), SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == -1) continue;
+
+			if (const auto request = client.Receive(); request) {
+				client.Send(Respond(*request));
+			}
+		}
+#endif
+	}
+
+	std::string Server::Respond(const std::string& request) {
+		// A build that did not change its inputs gets the result it got last time
+		if (const auto result = std::find_if(m_Results.begin(), m_Results.end(), [&](const auto& result) {
+				return result.first == request;
+			}); result != m_Results.end()) return result->second;
+
+		MessageReader reader(request);
+		std::uint64_t argumentCount;
+		std::vector<std::string> arguments;
+		std::vector<std::pair<std::string, std::string>> files;
+
+		bool isValid = reader.ReadSize(argumentCount) && argumentCount <= request.size() / 8;
+
+		for (std::uint64_t i = 0; isValid && i < argumentCount; ++i) {
+			isValid = reader.ReadString(arguments.emplace_back());
+		}
+
+		isValid = isValid && reader.ReadPairs(files) && reader.IsEnd();
+
+		const auto options = isValid ? ParseArguments(arguments) : std::nullopt;
+
+		if (!options) return EncodeResponse({
+			.ExitCode = EXIT_FAILURE,
+			.Errors = "error: Invalid request\n",
+		});
+
+		const auto response = EncodeResponse(RunDriver(*options, [&](const std::string& path) -> std::optional<std::string> {
+			const auto file = std::find_if(files.begin(), files.end(), [&](const auto& file) {
+				return file.first == path;
+			});
+
+			if (file == files.end()) return std::nullopt;
+			else return file->second;
+		}));
+
+		if (m_Results.size() == MaxResultCount) {
+			m_Results.erase(m_Results.begin());
+		}
+
+		m_Results.push_back({ request, response });
+
+		return response;
+	}
+
+	std::optional<DriverResult> RequestCompile(const std::string& socketPath, const std::vector<std::string>& arguments,
+		const std::vector<std::pair<std::string, std::string>>& files) {
+#ifdef _WIN32
+		return std::nullopt;
+#else
+		const auto address = MakeAddress(socketPath);
+		if (!address) return std::nullopt;
+
+		const Socket server(socket(AF_UNIX, SOCK_STREAM, 0));
+
+		if (server.Get() == -1 ||
+			connect(server.Get(), reinterpret_cast<const sockaddr*>(&*address), sizeof(*address)) == -1 ||
+			!server.Send(EncodeRequest(arguments, files))) return std::nullopt;
+
+		const auto response = server.Receive();
+		if (!response) return std::nullopt;
+
+		return DecodeResponse(*response);
+#endif
+	}
+}
\ No newline at end of file
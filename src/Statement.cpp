@@ -4,10 +4,10 @@
 #include <utility>
 
 namespace chit {
-	JsonValue EmptyStatementNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"EmptyStatementNode").
-			Build();
+	void EmptyStatementNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"EmptyStatementNode").
+			EndObject();
 	}
 }
 
@@ -20,11 +20,14 @@ namespace chit {
 		assert(Expression);
 	}
 
-	JsonValue ExpressionStatementNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"ExpressionStatementNode").
-			SetField(u8"expression", Expression->DumpJson()).
-			Build();
+	void ExpressionStatementNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"ExpressionStatementNode").
+			Key(u8"expression");
+
+		Expression->DumpJson(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -35,11 +38,14 @@ namespace chit {
 		assert(Expression);
 	}
 
-	JsonValue ReturnNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"ReturnNode").
-			SetField(u8"expression", Expression->DumpJson()).
-			Build();
+	void ReturnNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"ReturnNode").
+			Key(u8"expression");
+
+		Expression->DumpJson(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -56,12 +62,25 @@ namespace chit {
 		assert(Body);
 	}
 
-	JsonValue IfNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"IfNode").
-			SetField(u8"condition", Condition->DumpJson()).
-			SetField(u8"body", Body->DumpJson()).
-			SetField(u8"elseBody", ElseBody ? ElseBody->DumpJson() : JsonNull()).
-			Build();
+	void IfNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"IfNode").
+			Key(u8"condition");
+
+		Condition->DumpJson(writer);
+
+		writer.Key(u8"body");
+
+		Body->DumpJson(writer);
+
+		writer.Key(u8"elseBody");
+
+		if (ElseBody) {
+			ElseBody->DumpJson(writer);
+		} else {
+			writer.Null();
+		}
+
+		writer.EndObject();
 	}
 }
\ No newline at end of file
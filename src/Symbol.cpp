@@ -33,8 +33,10 @@ namespace chit {
 		auto& symbol = m_Symbols[name];
 
 		symbol = std::unique_ptr<Symbol>(new Symbol(VariableSymbol{
+			.Name = name,
 			.Type = std::move(type),
 			.State = state,
+			.IsGlobal = IsGlobal(),
 		}));
 
 		return symbol.get();
@@ -46,6 +48,15 @@ namespace chit {
 
 		auto& symbol = m_Symbols[name];
 
+		// Redeclarations share one symbol, so nodes analyzed against an earlier declaration stay valid
+		if (const auto function = IsFunctionSymbol(symbol.get()); function) {
+			const auto isSameType = function->Type->IsEqual(std::shared_ptr<FunctionType>(new FunctionType(
+				std::move(returnType),
+				std::move(parameterTypes))));
+
+			return isSameType ? symbol.get() : nullptr;
+		}
+
 		symbol = std::unique_ptr<Symbol>(new Symbol(FunctionSymbol{
 			.Type = std::shared_ptr<FunctionType>(new FunctionType(
 				std::move(returnType),
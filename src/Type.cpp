@@ -20,49 +20,68 @@ namespace chit {
 	const std::shared_ptr<BuiltinType> BuiltinType::Void =
 		std::make_shared<BuiltinType>(u8"void");
 	const std::shared_ptr<BuiltinType> BuiltinType::Int =
-		std::make_shared<BuiltinType>(u8"int", 0);
+		std::make_shared<BuiltinType>(u8"int", 0, 4);
 	const std::shared_ptr<BuiltinType> BuiltinType::UnsignedInt =
-		std::make_shared<BuiltinType>(u8"unsigned int", 0);
+		std::make_shared<BuiltinType>(u8"unsigned int", 0, 4);
 	const std::shared_ptr<BuiltinType> BuiltinType::LongInt =
-		std::make_shared<BuiltinType>(u8"long int", 1);
+		std::make_shared<BuiltinType>(u8"long int", 1, 4);
 	const std::shared_ptr<BuiltinType> BuiltinType::UnsignedLongInt =
-		std::make_shared<BuiltinType>(u8"unsigned long int", 1);
+		std::make_shared<BuiltinType>(u8"unsigned long int", 1, 4);
 	const std::shared_ptr<BuiltinType> BuiltinType::LongLongInt =
-		std::make_shared<BuiltinType>(u8"long long int", 2);
+		std::make_shared<BuiltinType>(u8"long long int", 2, 8);
 	const std::shared_ptr<BuiltinType> BuiltinType::UnsignedLongLongInt =
-		std::make_shared<BuiltinType>(u8"unsigned long long int", 2);
+		std::make_shared<BuiltinType>(u8"unsigned long long int", 2, 8);
 
 	BuiltinType::BuiltinType(std::u8string_view name) noexcept
 		: Name(name) {
 
 		assert(!Name.empty());
 	}
-	BuiltinType::BuiltinType(std::u8string_view name, int rank) noexcept
-		: Name(name), Rank(rank) {
+	BuiltinType::BuiltinType(std::u8string_view name, int rank, std::size_t size) noexcept
+		: Name(name), Rank(rank), Size(size) {
 
 		assert(!Name.empty());
+		assert(Size > 0);
 	}
 
-	JsonValue BuiltinType::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"BuiltinType").
-			SetField(u8"name", std::u8string(Name)).
-			SetField(u8"rank", Rank ? *Rank : JsonNull()).
-			Build();
+	void BuiltinType::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"BuiltinType").
+			Key(u8"name").String(Name).
+			Key(u8"rank");
+
+		if (Rank) {
+			writer.Integer(static_cast<std::int64_t>(*Rank));
+		} else {
+			writer.Null();
+		}
+
+		writer.EndObject();
 	}
-	void BuiltinType::GenerateConvert(GeneratorContext& context) const {
+	void BuiltinType::GenerateConvert(
+		GeneratorContext& context,
+		const TypePtr& from) const {
+
 		assert(!IsVoid());
 		assert(Rank);
 		assert(context.Stream);
 
-		switch (*Rank) {
-		case 0:
-		case 1:
+		const auto builtinFrom = IsBuiltinType(from);
+
+		assert(builtinFrom);
+		assert(!builtinFrom->IsVoid());
+
+		// Signedness only changes how the bits are read, so the same representation needs no instruction
+		if (builtinFrom->Size == Size)
+			return;
+
+		switch (Size) {
+		case 4:
 			*context.Stream << u8"toi\n";
 
 			break;
 
-		case 2:
+		case 8:
 			*context.Stream << u8"tol\n";
 
 			break;
@@ -78,6 +97,19 @@ namespace chit {
 	bool BuiltinType::IsUnsigned() const noexcept {
 		return Name.front() == u8'u';
 	}
+	std::shared_ptr<BuiltinType> BuiltinType::GetUnsignedType() const noexcept {
+		if (this == Int.get() || this == UnsignedInt.get()) {
+			return UnsignedInt;
+		} else if (this == LongInt.get() || this == UnsignedLongInt.get()) {
+			return UnsignedLongInt;
+		} else if (this == LongLongInt.get() || this == UnsignedLongLongInt.get()) {
+			return UnsignedLongLongInt;
+		} else {
+			assert(false);
+
+			return nullptr;
+		}
+	}
 
 	TypePtr BuiltinType::RunUsualArithmeticConversion(
 		TypePtr& newLeftType, const TypePtr& leftType,
@@ -119,14 +151,28 @@ namespace chit {
 			newSignedType = unsignedType;
 
 			return newSignedType;
-		} else {
+		} else if (signedType->Size > unsignedType->Size) {
 			newUnsignedType = signedType;
 
+			return newUnsignedType;
+		} else {
+			// The signed type cannot hold every value of the unsigned type
+			newUnsignedType = signedType->GetUnsignedType();
+			newSignedType = newUnsignedType;
+
 			return newUnsignedType;
 		}
 	}
-	void BuiltinType::RunIntegerPromotion(TypePtr&, const TypePtr&) {
-		// TODO
+	void BuiltinType::RunIntegerPromotion(TypePtr& newType, const TypePtr& type) {
+		const auto builtinType = IsBuiltinType(type);
+		if (!builtinType || !builtinType->Rank || *builtinType->Rank >= *Int->Rank)
+			return;
+
+		if (builtinType->IsUnsigned() && builtinType->Size >= Int->Size) {
+			newType = UnsignedInt;
+		} else {
+			newType = Int;
+		}
 	}
 
 	std::shared_ptr<BuiltinType> IsBuiltinType(const TypePtr& type) noexcept {
@@ -145,20 +191,23 @@ namespace chit {
 		assert(ReturnType);
 	}
 
-	JsonValue FunctionType::DumpJson() const {
-		JsonArray parameterTypes;
+	void FunctionType::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"FunctionType").
+			Key(u8"returnType");
+
+		ReturnType->DumpJson(writer);
+
+		writer.Key(u8"parameterTypes").BeginArray();
 
 		for (const auto& paramType : ParameterTypes) {
-			parameterTypes.AddElement(paramType->DumpJson());
+			paramType->DumpJson(writer);
 		}
 
-		return JsonObject().
-			SetField(u8"class", u8"FunctionType").
-			SetField(u8"returnType", ReturnType->DumpJson()).
-			SetField(u8"parameterTypes", parameterTypes.Build()).
-			Build();
+		writer.EndArray().
+			EndObject();
 	}
-	void FunctionType::GenerateConvert(GeneratorContext&) const {
+	void FunctionType::GenerateConvert(GeneratorContext&, const TypePtr&) const {
 		assert(false);
 	}
 
@@ -9,33 +9,41 @@ namespace chit {
 	FunctionDeclarationNode::FunctionDeclarationNode(
 		std::unique_ptr<TypeNode> returnType,
 		std::u8string_view name,
+		std::size_t nameOffset,
 		std::vector<std::pair<
 			std::u8string_view,
 			std::unique_ptr<TypeNode>>> parameters) noexcept
 
-		: ReturnType(std::move(returnType)), Name(name),
+		: ReturnType(std::move(returnType)), Name(name), NameOffset(nameOffset),
 		Parameters(std::move(parameters)) {
 
 		assert(ReturnType);
 		assert(!Name.empty());
 	}
 
-	JsonValue FunctionDeclarationNode::DumpJson() const {
-		JsonArray parameters;
+	void FunctionDeclarationNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"FunctionDeclarationNode").
+			Key(u8"returnType");
+
+		ReturnType->DumpJson(writer);
+
+		writer.
+			Key(u8"name").String(Name).
+			Key(u8"parameters").BeginArray();
 
 		for (const auto& [name, value] : Parameters) {
-			parameters.AddElement(JsonObject().
-				SetField(u8"name", std::u8string(name)).
-				SetField(u8"type", value->DumpJson()).
-				Build());
+			writer.BeginObject().
+				Key(u8"name").String(name).
+				Key(u8"type");
+
+			value->DumpJson(writer);
+
+			writer.EndObject();
 		}
 
-		return JsonObject().
-			SetField(u8"class", u8"FunctionDeclarationNode").
-			SetField(u8"returnType", ReturnType->DumpJson()).
-			SetField(u8"name", std::u8string(Name)).
-			SetField(u8"parameters", parameters.Build()).
-			Build();
+		writer.EndArray().
+			EndObject();
 	}
 }
 
@@ -50,12 +58,18 @@ namespace chit {
 		assert(Body);
 	}
 
-	JsonValue FunctionDefinitionNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"FunctionDefinitionNode").
-			SetField(u8"prototype", Prototype->DumpJson()).
-			SetField(u8"body", Body->DumpJson()).
-			Build();
+	void FunctionDefinitionNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"FunctionDefinitionNode").
+			Key(u8"prototype");
+
+		Prototype->DumpJson(writer);
+
+		writer.Key(u8"body");
+
+		Body->DumpJson(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -63,21 +77,33 @@ namespace chit {
 	VariableDeclarationNode::VariableDeclarationNode(
 		std::unique_ptr<TypeNode> type,
 		std::u8string_view name,
+		std::size_t nameOffset,
 		std::unique_ptr<ExpressionNode> initializer) noexcept
 
-		: Type(std::move(type)), Name(std::move(name)),
+		: Type(std::move(type)), Name(std::move(name)), NameOffset(nameOffset),
 		Initializer(std::move(initializer)) {
 
 		assert(Type);
 		assert(!Name.empty());
 	}
 
-	JsonValue VariableDeclarationNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"VariableDeclarationNode").
-			SetField(u8"type", Type->DumpJson()).
-			SetField(u8"name", std::u8string(Name)).
-			SetField(u8"initializer", Initializer ? Initializer->DumpJson() : JsonNull()).
-			Build();
+	void VariableDeclarationNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"VariableDeclarationNode").
+			Key(u8"type");
+
+		Type->DumpJson(writer);
+
+		writer.
+			Key(u8"name").String(Name).
+			Key(u8"initializer");
+
+		if (Initializer) {
+			Initializer->DumpJson(writer);
+		} else {
+			writer.Null();
+		}
+
+		writer.EndObject();
 	}
 }
\ No newline at end of file
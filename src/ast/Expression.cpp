@@ -15,12 +15,14 @@ namespace chit {
 		assert(!Name.empty());
 	}
 
-	JsonValue IdentifierNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"IdentifierNode").
-			SetField(u8"name", std::u8string(Name)).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void IdentifierNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"IdentifierNode").
+			Key(u8"name").String(Name);
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -28,12 +30,14 @@ namespace chit {
 	IntConstantNode::IntConstantNode(std::int32_t value) noexcept
 		: Value(value) {}
 
-	JsonValue IntConstantNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"IntConstantNode").
-			SetField(u8"value", static_cast<std::int64_t>(Value)).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void IntConstantNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"IntConstantNode").
+			Key(u8"value").Integer(static_cast<std::int64_t>(Value));
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -41,12 +45,14 @@ namespace chit {
 	UnsignedIntConstantNode::UnsignedIntConstantNode(std::uint32_t value) noexcept
 		: Value(value) {}
 
-	JsonValue UnsignedIntConstantNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"UnsignedIntConstantNode").
-			SetField(u8"value", static_cast<std::uint64_t>(Value)).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void UnsignedIntConstantNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"UnsignedIntConstantNode").
+			Key(u8"value").Integer(static_cast<std::uint64_t>(Value));
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -54,12 +60,14 @@ namespace chit {
 	LongIntConstantNode::LongIntConstantNode(std::int32_t value) noexcept
 		: Value(value) {}
 
-	JsonValue LongIntConstantNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"LongIntConstantNode").
-			SetField(u8"value", static_cast<std::int64_t>(Value)).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void LongIntConstantNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"LongIntConstantNode").
+			Key(u8"value").Integer(static_cast<std::int64_t>(Value));
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -67,12 +75,14 @@ namespace chit {
 	UnsignedLongIntConstantNode::UnsignedLongIntConstantNode(std::uint32_t value) noexcept
 		: Value(value) {}
 
-	JsonValue UnsignedLongIntConstantNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"UnsignedLongIntConstantNode").
-			SetField(u8"value", static_cast<std::uint64_t>(Value)).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void UnsignedLongIntConstantNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"UnsignedLongIntConstantNode").
+			Key(u8"value").Integer(static_cast<std::uint64_t>(Value));
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -80,12 +90,14 @@ namespace chit {
 	LongLongIntConstantNode::LongLongIntConstantNode(std::int64_t value) noexcept
 		: Value(value) {}
 
-	JsonValue LongLongIntConstantNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"LongLongIntConstantNode").
-			SetField(u8"value", Value).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void LongLongIntConstantNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"LongLongIntConstantNode").
+			Key(u8"value").Integer(Value);
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -93,12 +105,14 @@ namespace chit {
 	UnsignedLongLongIntConstantNode::UnsignedLongLongIntConstantNode(std::uint64_t value) noexcept
 		: Value(value) {}
 
-	JsonValue UnsignedLongLongIntConstantNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"UnsignedLongLongIntConstantNode").
-			SetField(u8"value", Value).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void UnsignedLongLongIntConstantNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"UnsignedLongLongIntConstantNode").
+			Key(u8"value").Integer(Value);
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -128,14 +142,21 @@ namespace chit {
 		assert(Right);
 	}
 
-	JsonValue BinaryOperatorNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"class", u8"BinaryOperatorNode").
-			SetField(u8"operator", std::u8string(TokenSymbols.at(Operator))).
-			SetField(u8"left", Left->DumpJson()).
-			SetField(u8"right", Right->DumpJson()).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+	void BinaryOperatorNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"BinaryOperatorNode").
+			Key(u8"operator").String(TokenSymbols.at(Operator)).
+			Key(u8"left");
+
+		Left->DumpJson(writer);
+
+		writer.Key(u8"right");
+
+		Right->DumpJson(writer);
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
 
@@ -149,18 +170,23 @@ namespace chit {
 		assert(Function);
 	}
 
-	JsonValue FunctionCallNode::DumpJson() const {
-		JsonArray arguments;
+	void FunctionCallNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"FunctionCallNode").
+			Key(u8"function");
+
+		Function->DumpJson(writer);
+
+		writer.Key(u8"arguments").BeginArray();
 
 		for (const auto& argument : Arguments) {
-			arguments.AddElement(argument->DumpJson());
+			argument->DumpJson(writer);
 		}
 
-		return JsonObject().
-			SetField(u8"class", u8"FunctionCallNode").
-			SetField(u8"function", Function->DumpJson()).
-			SetField(u8"arguments", arguments.Build()).
-			Merge(ExpressionNode::DumpJson()).
-			Build();
+		writer.EndArray();
+
+		ExpressionNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
\ No newline at end of file
@@ -6,34 +6,43 @@
 #include <utility>
 
 namespace chit {
-	JsonValue TypeNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"type", Type ? Type->DumpJson() : JsonNull()).
-			Build();
+	void TypeNode::DumpJsonFields(JsonWriter& writer) const {
+		writer.Key(u8"type");
+
+		if (Type) {
+			Type->DumpJson(writer);
+		} else {
+			writer.Null();
+		}
 	}
 }
 
 namespace chit {
-	JsonValue ExpressionNode::DumpJson() const {
-		return JsonObject().
-			SetField(u8"type", Type ? Type->DumpJson() : JsonNull()).
-			SetField(u8"isLValue", IsLValue).
-			Build();
+	void ExpressionNode::DumpJsonFields(JsonWriter& writer) const {
+		writer.Key(u8"type");
+
+		if (Type) {
+			Type->DumpJson(writer);
+		} else {
+			writer.Null();
+		}
+
+		writer.Key(u8"isLValue").Boolean(IsLValue);
 	}
 }
 
 namespace chit {
-	JsonValue RootNode::DumpJson() const {
-		JsonArray statements;
+	void RootNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"RootNode").
+			Key(u8"statements").BeginArray();
 
 		for (const auto& statement : Statements) {
-			statements.AddElement(statement->DumpJson());
+			statement->DumpJson(writer);
 		}
 
-		return JsonObject().
-			SetField(u8"class", u8"RootNode").
-			SetField(u8"statements", statements.Build()).
-			Build();
+		writer.EndArray().
+			EndObject();
 	}
 }
 
@@ -41,16 +50,16 @@ namespace chit {
 	BlockNode::BlockNode(std::vector<std::unique_ptr<StatementNode>> statements) noexcept
 		: Statements(std::move(statements)) {}
 
-	JsonValue BlockNode::DumpJson() const {
-		JsonArray statements;
+	void BlockNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"BlockNode").
+			Key(u8"statements").BeginArray();
 
 		for (const auto& statement : Statements) {
-			statements.AddElement(statement->DumpJson());
+			statement->DumpJson(writer);
 		}
 
-		return JsonObject().
-			SetField(u8"class", u8"BlockNode").
-			SetField(u8"statements", statements.Build()).
-			Build();
+		writer.EndArray().
+			EndObject();
 	}
 }
\ No newline at end of file
@@ -21,17 +21,19 @@ namespace chit {
 		assert(!Names[0].empty());
 	}
 
-	JsonValue IdentifierTypeNode::DumpJson() const {
-		JsonArray names;
+	void IdentifierTypeNode::DumpJson(JsonWriter& writer) const {
+		writer.BeginObject().
+			Key(u8"class").String(u8"IdentifierTypeNode").
+			Key(u8"names").BeginArray();
 
 		for (const auto& name : Names) {
-			names.AddElement(std::u8string(name));
+			writer.String(name);
 		}
 
-		return JsonObject().
-			SetField(u8"class", u8"IdentifierTypeNode").
-			SetField(u8"names", names.Build()).
-			Merge(TypeNode::DumpJson()).
-			Build();
+		writer.EndArray();
+
+		TypeNode::DumpJsonFields(writer);
+
+		writer.EndObject();
 	}
 }
\ No newline at end of file
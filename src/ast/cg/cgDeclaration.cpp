@@ -1,10 +1,39 @@
 #include <chit/ast/Declaration.hpp>
 
 #include <chit/Generator.hpp>
+#include <chit/Parser.hpp>
+#include <chit/ast/Statement.hpp>
+#include <chit/util/String.hpp>
 
 #include <algorithm>
 #include <cassert>
-#include <iterator>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace chit {
+	namespace {
+		std::size_t CountInstructions(std::u8string_view code) noexcept {
+			// Labels and function headers are free
+			std::size_t count = 0;
+
+			while (!code.empty()) {
+				const auto lineEnd = code.find(u8'\n');
+				const auto line = code.substr(0, lineEnd);
+
+				if (!line.empty() && !line.ends_with(u8':')) {
+					++count;
+				}
+
+				code.remove_prefix(lineEnd == std::u8string_view::npos ? code.size() : lineEnd + 1);
+			}
+
+			return count;
+		}
+	}
+}
 
 namespace chit {
 	void FunctionDeclarationNode::Generate(GeneratorContext&) const {
@@ -16,34 +45,295 @@ namespace chit {
 	void FunctionDefinitionNode::Generate(chit::GeneratorContext& context) const {
 		Prototype->Generate(context);
 
+		GenerateFunction(context, Prototype->Name, {}, false);
+	}
+	void FunctionDefinitionNode::GenerateFunction(
+		GeneratorContext& context,
+		std::u8string_view name,
+		std::span<const std::optional<Constant>> arguments,
+		bool isMeasuring) const {
+
+		Frame frame;
+
+		// Parameters take the first slots in declaration order and live for the whole body. Specialized ones are constants instead
+		std::vector<std::size_t> parameterSlots;
 		std::vector<std::u8string_view> parameterNames;
-		std::transform(
-			Prototype->Parameters.begin(),
-			Prototype->Parameters.end(),
-			std::back_inserter(parameterNames),
-			[](const auto& parameter) {
-				return parameter.first;
-			});
+
+		for (std::size_t i = 0; i < Prototype->Parameters.size(); ++i) {
+			if (!arguments.empty() && arguments[i]) continue;
+
+			parameterSlots.push_back(frame.AllocateSlot(Prototype->Parameters[i].second->Type));
+			parameterNames.push_back(context.Assembly.GetLocalIdentifier(parameterSlots.back()));
+		}
 
 		auto& bodyStream = context.Assembly.AddFunction(
-			Prototype->Name,
+			name,
 			!Prototype->ReturnType->Type->IsVoid(),
 			std::move(parameterNames));
 
+		FunctionContext function{
+			.Definition = this,
+			.Name = name,
+			.Arguments = arguments,
+			.IsMeasuring = isMeasuring,
+		};
+		BodyStream body;
 		GeneratorContext defContext{
 			.Parent = &context,
 			.Assembly = context.Assembly,
-			.Stream = &bodyStream,
+			.Profile = context.Profile,
+			.Stream = &body,
+			.Frame = &frame,
+			.Function = &function,
 			.Messages = context.Messages,
 		};
 
+		function.EntryLabel = defContext.CreateTempIdentifier();
+
+		for (std::size_t i = 0, slot = 0; i < Prototype->Parameters.size(); ++i) {
+			const auto symbol = GetParameterSymbol(i);
+
+			if (!arguments.empty() && arguments[i]) {
+				defContext.Constants.insert({ symbol, *arguments[i] });
+			} else if (const auto parameterSlot = parameterSlots[slot++]; symbol) {
+				defContext.Locals[symbol] = parameterSlot;
+				context.Assembly.AddSourceName(name, parameterSlot, symbol->Name);
+			}
+		}
+
 		Body->Generate(defContext);
 
-		if (Prototype->Name == u8"main") {
-			bodyStream << u8"push 0i\n";
+		// Self tail calls jump back here, so the label is only emitted when one was generated
+		if (function.IsEntryLabelUsed) {
+			bodyStream << function.EntryLabel << u8":\n";
 		}
 
-		bodyStream << u8"ret\n";
+		bodyStream << body.view();
+
+		if (defContext.GetFlow().IsReachable) {
+			if (Prototype->Name == u8"main") {
+				bodyStream << u8"push 0i\n";
+			}
+
+			bodyStream << u8"ret\n";
+		}
+
+		bodyStream << function.ColdBlocks.view();
+
+		context.Assembly.SetFrameSize(name, frame.GetSize());
+	}
+
+	bool FunctionDefinitionNode::CanInline(const GeneratorContext& context) const {
+		if (context.IsGenerating(this) || Prototype->Name == u8"main") return false;
+
+		// With a profile, functions that never ran stay out of line and hot ones get a larger budget
+		auto threshold = InlineThreshold;
+
+		if (context.Profile) {
+			if (context.Profile->GetCallCount(Prototype->Name) == 0u) return false;
+			else if (context.Profile->IsHot(Prototype->Name)) {
+				threshold = HotInlineThreshold;
+			}
+		}
+
+		return GetInlineCost() <= threshold;
+	}
+	void FunctionDefinitionNode::GenerateInline(GeneratorContext& context, std::span<const std::optional<Constant>> arguments) const {
+		assert(context.Stream);
+		assert(IsInlinable());
+
+		GeneratorContext inlineContext{
+			.Parent = &context,
+			.Assembly = context.Assembly,
+			.Profile = context.Profile,
+			.Stream = context.Stream,
+			.Frame = context.Frame,
+			.Function = context.Function,
+			.InlinedFunction = this,
+			.Messages = context.Messages,
+		};
+
+		// The arguments were pushed as for a call, so the first one is on top. Each parameter gets a fresh slot of the caller's frame
+		// Constant arguments were not pushed, and are propagated into the body as for a specialization
+		for (std::size_t i = 0; i < Prototype->Parameters.size(); ++i) {
+			if (!arguments.empty() && arguments[i]) {
+				const auto symbol = GetParameterSymbol(i);
+
+				inlineContext.AssignValue(symbol, std::nullopt);
+				inlineContext.Constants.insert({ symbol, *arguments[i] });
+			} else if (const auto symbol = GetParameterSymbol(i); symbol) {
+				const auto slot = inlineContext.CreateLocal(symbol, symbol->Type);
+
+				*context.Stream << u8"store " << context.Assembly.GetLocalIdentifier(slot) << u8'\n';
+
+				// A value left from an earlier inlining of the same function no longer holds
+				inlineContext.AssignValue(symbol, std::nullopt);
+			} else {
+				*context.Stream << u8"pop\n";
+			}
+		}
+
+		for (const auto& statement : Body->Statements) {
+			if (const auto returnNode = dynamic_cast<const ReturnNode*>(statement.get()); returnNode) {
+				returnNode->Expression->GenerateRValue(inlineContext, returnNode->FunctionReturnType);
+			} else {
+				statement->Generate(inlineContext);
+			}
+		}
+
+		inlineContext.DeleteLocals();
+	}
+
+	std::optional<std::u8string_view> FunctionDefinitionNode::GetSpecialization(
+		const GeneratorContext& context,
+		const std::vector<std::optional<Constant>>& arguments) const {
+
+		assert(arguments.size() == Prototype->Parameters.size());
+
+		if (Prototype->Name == u8"main") return std::nullopt;
+		if (context.Profile && context.Profile->GetCallCount(Prototype->Name) == 0u) return std::nullopt;
+
+		if (const auto specialization = std::find_if(Specializations.begin(), Specializations.end(),
+				[&arguments](const auto& specialization) { return specialization.Arguments == arguments; });
+			specialization != Specializations.end()) {
+
+			if (specialization->IsAccepted) return specialization->Name;
+			else return std::nullopt;
+		}
+
+		// A clone is only worth it when the constants fold some of the body away, and all clones together stay within the budget
+		const auto cost = GetCost({});
+		const auto specializedCost = GetCost(arguments);
+		const bool isAccepted =
+			specializedCost < cost &&
+			SpecializedCost + specializedCost <= cost * SpecializationGrowth;
+
+		auto& specialization = Specializations.emplace_back(Specialization{
+			.Arguments = arguments,
+			.Name = std::u8string(Prototype->Name) + u8"_ChitLangSpecialization" + ToUtf8String(Specializations.size()),
+			.IsAccepted = isAccepted,
+		});
+
+		if (!isAccepted) return std::nullopt;
+
+		SpecializedCost += specializedCost;
+
+		return specialization.Name;
+	}
+	bool FunctionDefinitionNode::GenerateSpecializations(GeneratorContext& context) const {
+		bool isGenerated = false;
+
+		// Generating a clone may request further clones, which are appended while iterating
+		for (std::size_t i = 0; i < Specializations.size(); ++i) {
+			auto& specialization = Specializations[i];
+			if (!specialization.IsAccepted || specialization.IsGenerated) continue;
+
+			specialization.IsGenerated = true;
+			isGenerated = true;
+
+			GenerateFunction(context, specialization.Name, specialization.Arguments, false);
+		}
+
+		return isGenerated;
+	}
+
+	std::optional<Constant> FunctionDefinitionNode::Evaluate(
+		const GeneratorContext& context,
+		const std::vector<Constant>& arguments) const {
+
+		if (Prototype->Name == u8"main") return std::nullopt;
+
+		if (const auto evaluation = std::find_if(Evaluations.begin(), Evaluations.end(),
+				[&arguments](const auto& evaluation) { return evaluation.first == arguments; });
+			evaluation != Evaluations.end()) {
+
+			return evaluation->second;
+		}
+
+		std::optional<Constant> result;
+
+		if (context.Interpreter) {
+			result = context.Interpreter->Call(this, arguments);
+		} else {
+			Interpreter interpreter;
+
+			result = interpreter.Call(this, arguments);
+		}
+
+		// A failure within a larger evaluation may only mean that the budget of that evaluation ran out
+		if (result || !context.Interpreter) {
+			Evaluations.push_back({ arguments, result });
+		}
+
+		return result;
+	}
+
+	VariableSymbol* FunctionDefinitionNode::GetParameterSymbol(std::size_t index) const {
+		const auto name = Prototype->Parameters[index].first;
+		if (name.empty()) return nullptr;
+
+		return IsVariableSymbol(ParserContext->SymbolTable.FindSymbol(name)->first);
+	}
+	bool FunctionDefinitionNode::IsInlinable() const noexcept {
+		const auto& statements = Body->Statements;
+
+		// Only straight-line bodies are inlined, so control never has to leave the inlined code early
+		for (std::size_t i = 0; i < statements.size(); ++i) {
+			const auto statement = statements[i].get();
+
+			if (dynamic_cast<const ReturnNode*>(statement)) {
+				if (i != statements.size() - 1) return false;
+			} else if (
+				!dynamic_cast<const VariableDeclarationNode*>(statement) &&
+				!dynamic_cast<const ExpressionStatementNode*>(statement) &&
+				!dynamic_cast<const EmptyStatementNode*>(statement)) return false;
+		}
+
+		if (Prototype->ReturnType->Type->IsVoid()) return true;
+		else return !statements.empty() && dynamic_cast<const ReturnNode*>(statements.back().get());
+	}
+	std::size_t FunctionDefinitionNode::GetInlineCost() const {
+		if (InlineCost) return *InlineCost;
+
+		// Marked as too expensive first, so a call cycle met while measuring is never inlined
+		InlineCost = static_cast<std::size_t>(-1);
+
+		if (!IsInlinable()) return *InlineCost;
+
+		Assembly assembly;
+		BodyStream stream;
+		Frame frame;
+		std::vector<Message> messages;
+		GeneratorContext costContext{
+			.Assembly = assembly,
+			.Stream = &stream,
+			.Frame = &frame,
+			.Messages = messages,
+		};
+
+		GenerateInline(costContext);
+
+		return *(InlineCost = CountInstructions(stream.view()));
+	}
+	std::size_t FunctionDefinitionNode::GetCost(std::span<const std::optional<Constant>> arguments) const {
+		if (arguments.empty() && Cost) return *Cost;
+
+		Assembly assembly;
+		std::vector<Message> messages;
+		GeneratorContext costContext{
+			.Assembly = assembly,
+			.Messages = messages,
+		};
+
+		GenerateFunction(costContext, Prototype->Name, arguments, true);
+
+		const auto cost = CountInstructions(assembly.Generate());
+
+		if (arguments.empty()) {
+			Cost = cost;
+		}
+
+		return cost;
 	}
 }
 
@@ -52,14 +342,77 @@ namespace chit {
 		assert(Symbol);
 		assert(context.Stream);
 
+		// A variable that is never assigned again holds its initial value everywhere, so it needs no slot
+		if (Initializer && !Symbol->IsModified) {
+			if (const auto constant = Initializer->EvaluateConstant(context); constant) {
+				context.Constants.insert({ Symbol, constant->Convert(Type->Type) });
+
+				return;
+			}
+		}
+
+		const auto isValueNumbered = Initializer && !Symbol->IsModified && !Initializer->HasSideEffect();
+
+		if (Initializer && !Symbol->IsModified) {
+			if (const auto range = Range::Convert(Initializer->EvaluateRange(context), Type->Type); range) {
+				context.Ranges.insert({ Symbol, *range });
+			}
+		}
+
+		// An earlier variable that still holds the same value lends its slot instead of computing the value again
+		if (isValueNumbered) {
+			if (const auto slot = context.FindExpression(*Initializer, Type->Type); slot) {
+				context.Aliases.insert({ Symbol, *slot });
+
+				if (context.Function) {
+					context.Assembly.AddSourceName(context.Function->Name, *slot, Symbol->Name);
+				}
+
+				return;
+			}
+		}
+
+		const auto slot = context.CreateLocal(Symbol, Type->Type);
+
 		if (Initializer) {
-			Initializer->GenerateValue(context);
+			const auto constant = Initializer->EvaluateConstant(context);
+
+			Initializer->GenerateRValue(context, Type->Type);
 
-			if (!Type->Type->IsEqual(Initializer->Type)) {
-				Type->Type->GenerateConvert(context);
+			*context.Stream << u8"store " << context.Assembly.GetLocalIdentifier(slot) << u8'\n';
+
+			if (Symbol->IsModified) {
+				context.AssignValue(Symbol, constant ? std::optional(constant->Convert(Type->Type)) : std::nullopt);
 			}
+		} else if (Symbol->IsModified) {
+			context.AssignValue(Symbol, std::nullopt);
+		}
+
+		if (isValueNumbered) {
+			context.GetFlow().Expressions.push_back({ Initializer.get(), Symbol });
+		}
+	}
+	std::optional<Completion> VariableDeclarationNode::Execute(GeneratorContext& context) const {
+		assert(Symbol);
+		assert(context.Interpreter);
+
+		if (!context.Interpreter->Step()) return std::nullopt;
+
+		const auto builtinType = IsBuiltinType(Type->Type);
+		if (!builtinType) return std::nullopt;
 
-			*context.Stream << u8"store " << Name << u8'\n';
+		// Reading an uninitialized variable is undefined, so it may as well start as zero
+		if (!Initializer) {
+			context.Constants.insert({ Symbol, Constant(builtinType, 0) });
+
+			return Completion{};
 		}
+
+		const auto value = Initializer->EvaluateConstant(context);
+		if (!value) return std::nullopt;
+
+		context.Constants.insert({ Symbol, value->Convert(Type->Type) });
+
+		return Completion{};
 	}
 }
\ No newline at end of file
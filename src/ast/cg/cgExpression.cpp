@@ -1,20 +1,29 @@
 #include <chit/ast/Expression.hpp>
 
 #include <chit/Generator.hpp>
+#include <chit/ast/Declaration.hpp>
 #include <chit/util/String.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <ranges>
 #include <unordered_map>
+#include <vector>
 
 namespace chit {
 	void IdentifierNode::GenerateValue(GeneratorContext& context) const {
 		assert(Type);
 		assert(context.Stream);
 
-		if (IsVariableSymbol(Symbol)) {
-			*context.Stream << u8"lea " << Name << u8'\n';
+		if (const auto varSymbol = IsVariableSymbol(Symbol); varSymbol) {
+			const auto slot = context.FindLocal(varSymbol);
+
+			assert(slot);
+
+			*context.Stream << u8"lea " << context.Assembly.GetLocalIdentifier(*slot) << u8'\n';
 		} else {
 			// TODO: Error
 		}
@@ -23,10 +32,16 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		if (IsVariableSymbol(Symbol)) {
+		if (const auto varSymbol = IsVariableSymbol(Symbol); varSymbol) {
+			const auto slot = context.FindLocal(varSymbol);
+
+			assert(slot);
+
+			const auto identifier = context.Assembly.GetLocalIdentifier(*slot);
+
 			*context.Stream <<
-				u8"store " << Name << u8'\n' <<
-				u8"load " << Name << u8'\n';
+				u8"store " << identifier << u8'\n' <<
+				u8"load " << identifier << u8'\n';
 		} else {
 			// TODO: Error
 		}
@@ -41,6 +56,24 @@ namespace chit {
 			// TODO: Error
 		}
 	}
+	std::optional<Constant> IdentifierNode::EvaluateConstant(const GeneratorContext& context) const {
+		if (const auto varSymbol = IsVariableSymbol(Symbol); varSymbol) return context.FindConstant(varSymbol);
+		else return std::nullopt;
+	}
+	bool IdentifierNode::IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const {
+		if (ExpressionNode::IsEquivalent(context, other)) return true;
+
+		const auto otherIdentifier = dynamic_cast<const IdentifierNode*>(&other);
+
+		return otherIdentifier && otherIdentifier->Symbol == Symbol;
+	}
+	std::optional<Range> IdentifierNode::EvaluateRange(const GeneratorContext& context) const {
+		if (const auto varSymbol = IsVariableSymbol(Symbol); varSymbol) {
+			if (const auto range = context.FindRange(varSymbol); range) return range;
+		}
+
+		return ExpressionNode::EvaluateRange(context);
+	}
 }
 
 namespace chit {
@@ -48,7 +81,10 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		*context.Stream << u8"push " << ToUtf8String(Value) << u8"i\n";
+		*context.Stream << u8"push " << ToUtf8Chars(Value) << u8"i\n";
+	}
+	std::optional<Constant> IntConstantNode::EvaluateConstant(const GeneratorContext&) const {
+		return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(Value));
 	}
 }
 
@@ -57,7 +93,10 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		*context.Stream << u8"push " << ToUtf8String(Value) << u8"i\n";
+		*context.Stream << u8"push " << ToUtf8Chars(Value) << u8"i\n";
+	}
+	std::optional<Constant> UnsignedIntConstantNode::EvaluateConstant(const GeneratorContext&) const {
+		return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(Value));
 	}
 }
 
@@ -66,7 +105,10 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		*context.Stream << u8"push " << ToUtf8String(Value) << u8"i\n";
+		*context.Stream << u8"push " << ToUtf8Chars(Value) << u8"i\n";
+	}
+	std::optional<Constant> LongIntConstantNode::EvaluateConstant(const GeneratorContext&) const {
+		return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(Value));
 	}
 }
 
@@ -75,7 +117,10 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		*context.Stream << u8"push " << ToUtf8String(Value) << u8"i\n";
+		*context.Stream << u8"push " << ToUtf8Chars(Value) << u8"i\n";
+	}
+	std::optional<Constant> UnsignedLongIntConstantNode::EvaluateConstant(const GeneratorContext&) const {
+		return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(Value));
 	}
 }
 
@@ -84,7 +129,10 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		*context.Stream << u8"push " << ToUtf8String(Value) << u8"l\n";
+		*context.Stream << u8"push " << ToUtf8Chars(Value) << u8"l\n";
+	}
+	std::optional<Constant> LongLongIntConstantNode::EvaluateConstant(const GeneratorContext&) const {
+		return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(Value));
 	}
 }
 
@@ -93,7 +141,10 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		*context.Stream << u8"push " << ToUtf8String(Value) << u8"l\n";
+		*context.Stream << u8"push " << ToUtf8Chars(Value) << u8"l\n";
+	}
+	std::optional<Constant> UnsignedLongLongIntConstantNode::EvaluateConstant(const GeneratorContext&) const {
+		return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(Value));
 	}
 }
 
@@ -103,19 +154,22 @@ namespace chit {
 		assert(context.Stream);
 
 		switch (Operator) {
-		case TokenType::Assignment:
-			Right->GenerateValue(context);
+		case TokenType::Assignment: {
+			const auto value = Right->EvaluateConstant(context);
 
-			if (Right->IsLValue) {
-				*context.Stream << u8"tload\n";
-			}
-			if (NewRightType) {
-				NewRightType->GenerateConvert(context);
-			}
+			Right->GenerateRValue(context, NewRightType);
 
 			Left->GenerateAssignment(context);
 
+			// The variable keeps the assigned value until the next assignment or join point that disagrees
+			if (const auto identifier = dynamic_cast<const IdentifierNode*>(Left.get()); identifier) {
+				if (const auto symbol = IsVariableSymbol(identifier->Symbol); symbol) {
+					context.AssignValue(symbol, value ? std::optional(value->Convert(Left->Type)) : std::nullopt);
+				}
+			}
+
 			break;
+		}
 
 		case TokenType::Addition:
 		case TokenType::Subtraction:
@@ -128,74 +182,341 @@ namespace chit {
 		case TokenType::GreaterThanOrEqual:
 		case TokenType::LessThanOrEqual: {
 
-			Left->GenerateValue(context);
+			// Operations whose values provably fit in an int are done in 32 bits
+			const auto computeType = GetComputeType(context);
+
+			GenerateOperation(context, computeType);
 
-			if (Left->IsLValue) {
-				*context.Stream << u8"tload\n";
+			if (computeType != OperandType && !IsComparison()) {
+				Type->GenerateConvert(context, computeType);
 			}
-			if (NewLeftType) {
-				NewLeftType->GenerateConvert(context);
+
+			break;
+		}
+		}
+	}
+	bool BinaryOperatorNode::GenerateNarrowValue(GeneratorContext& context) const {
+		switch (Operator) {
+		case TokenType::Addition:
+		case TokenType::Subtraction:
+		case TokenType::Multiplication:
+			// Only the low 32 bits are used, and these operations agree with the wider ones on them
+			GenerateOperation(context, BuiltinType::Int);
+
+			return true;
+
+		default:
+			return false;
+		}
+	}
+	std::optional<Constant> BinaryOperatorNode::EvaluateConstant(const GeneratorContext& context) const {
+		if (Operator == TokenType::Assignment) return std::nullopt;
+
+		const auto left = Left->EvaluateConstant(context);
+		const auto right = Right->EvaluateConstant(context);
+
+		if (left && right) return Constant::Evaluate(Operator, left->Convert(OperandType), right->Convert(OperandType), Type);
+
+		// A comparison can be decided by the ranges of its operands, as long as nothing is lost by not evaluating them
+		if (IsComparison() && !HasSideEffect()) {
+			if (const auto range = EvaluateRange(context); range && range->IsPoint()) {
+				return Constant(IsBuiltinType(Type), static_cast<std::uint64_t>(range->Min));
 			}
+		}
+
+		return std::nullopt;
+	}
+	std::optional<Range> BinaryOperatorNode::EvaluateRange(const GeneratorContext& context) const {
+		if (Operator == TokenType::Assignment) return Range::Convert(Right->EvaluateRange(context), Type);
+
+		const auto left = Range::Convert(Left->EvaluateRange(context), OperandType);
+		const auto right = Range::Convert(Right->EvaluateRange(context), OperandType);
+
+		if (left && right) {
+			if (const auto range = Range::Evaluate(Operator, *left, *right); range) return Range::Convert(range, Type);
+		}
+
+		if (IsComparison()) return Range{ .Min = 0, .Max = 1 };
+		else return Range::GetTypeRange(Type);
+	}
+	std::optional<bool> BinaryOperatorNode::PredictCondition(const GeneratorContext& context) const {
+		if (!IsComparison()) return std::nullopt;
+
+		// Ball-Larus opcode heuristic: equality with a constant and negative values are rarely met
+		const auto left = Left->EvaluateConstant(context);
+		const auto right = Right->EvaluateConstant(context);
+		if (!left == !right) return std::nullopt;
+
+		if (Operator == TokenType::Equivalence) return false;
+		if (!(left ? *left : *right).IsZero()) return std::nullopt;
+
+		const bool isLess = Operator == TokenType::LessThan || Operator == TokenType::LessThanOrEqual;
+
+		return isLess == static_cast<bool>(left);
+	}
+	std::size_t BinaryOperatorNode::GetStackNeed() const noexcept {
+		// The need only depends on the tree below, so every node computes it once
+		if (StackNeed) return *StackNeed;
 
-			Right->GenerateValue(context);
+		if (Operator == TokenType::Assignment) return *(StackNeed = Right->GetStackNeed());
 
-			if (Right->IsLValue) {
-				*context.Stream << u8"tload\n";
+		if (IsAssociative()) {
+			std::vector<Operand> operands;
+			CollectOperands(operands);
+
+			std::vector<std::size_t> needs;
+
+			for (const auto& operand : operands) {
+				needs.push_back(operand.StackNeed);
 			}
-			if (NewRightType) {
-				NewRightType->GenerateConvert(context);
+
+			std::sort(needs.begin(), needs.end(), std::greater<>{});
+
+			std::size_t need = needs.front();
+
+			for (std::size_t i = 1; i < needs.size(); ++i) {
+				need = std::max(need, needs[i] + 1);
 			}
 
-			const auto isUnsigned = IsBuiltinType(OperandType)->IsUnsigned();
-
-			switch (Operator) {
-			case TokenType::Addition:
-				*context.Stream << u8"add\n"; break;
-			case TokenType::Subtraction:
-				*context.Stream << u8"sub\n"; break;
-			case TokenType::Multiplication:
-				*context.Stream << (isUnsigned ? u8"mul\n" : u8"imul\n"); break;
-			case TokenType::Division:
-				*context.Stream << (isUnsigned ? u8"div\n" : u8"idiv\n"); break;
-			case TokenType::Modulo:
-				*context.Stream << (isUnsigned ? u8"mod\n" : u8"imod\n"); break;
-
-			case TokenType::Equivalence:
-			case TokenType::GreaterThan:
-			case TokenType::LessThan:
-			case TokenType::GreaterThanOrEqual:
-			case TokenType::LessThanOrEqual: {
-
-				const auto jumpLabelName = context.CreateTempIdentifier();
-				const auto doneLabelName = context.CreateTempIdentifier();
-
-				static const std::unordered_map<
-					TokenType,
-					std::u8string_view> jumpInstructions{
-
-					{ TokenType::Equivalence, u8"je" },
-					{ TokenType::GreaterThan, u8"ja" },
-					{ TokenType::LessThan, u8"jb" },
-					{ TokenType::GreaterThanOrEqual, u8"jae" },
-					{ TokenType::LessThanOrEqual, u8"jbe" },
-				};
-
-				*context.Stream <<
-					(isUnsigned ? u8"cmp\n" : u8"icmp\n") <<
-					jumpInstructions.at(Operator) << u8' ' << jumpLabelName << u8'\n' <<
-					u8"pop\n" <<
-					u8"push 0i\n" <<
-					u8"jmp " << doneLabelName << u8'\n' <<
-					jumpLabelName << u8":\n" <<
-					u8"push 1i\n" <<
-					doneLabelName << u8":\n";
-
-				break;
+			return *(StackNeed = need);
+		}
+
+		const auto leftNeed = Left->GetStackNeed();
+		const auto rightNeed = Right->GetStackNeed();
+
+		if (IsRightFirst()) return *(StackNeed = std::max(rightNeed, leftNeed + 1));
+		else return *(StackNeed = std::max(leftNeed, rightNeed + 1));
+	}
+	bool BinaryOperatorNode::HasSideEffect() const noexcept {
+		return
+			Operator == TokenType::Assignment ||
+			MayTrap() ||
+			Left->HasSideEffect() ||
+			Right->HasSideEffect();
+	}
+	bool BinaryOperatorNode::MayTrap() const noexcept {
+		if (Operator != TokenType::Division && Operator != TokenType::Modulo) return false;
+
+		// Only a literal divisor is known without a context. Literals are never negative, so -1 cannot overflow either
+		const auto isNonzero = [this]<typename T>() {
+			const auto literal = dynamic_cast<const T*>(Right.get());
+
+			return literal && literal->Value != 0;
+		};
+
+		return !(
+			isNonzero.operator()<IntConstantNode>() ||
+			isNonzero.operator()<UnsignedIntConstantNode>() ||
+			isNonzero.operator()<LongIntConstantNode>() ||
+			isNonzero.operator()<UnsignedLongIntConstantNode>() ||
+			isNonzero.operator()<LongLongIntConstantNode>() ||
+			isNonzero.operator()<UnsignedLongLongIntConstantNode>());
+	}
+
+	bool BinaryOperatorNode::IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const {
+		if (ExpressionNode::IsEquivalent(context, other)) return true;
+
+		const auto otherOperator = dynamic_cast<const BinaryOperatorNode*>(&other);
+
+		return
+			otherOperator && otherOperator->Operator == Operator && Operator != TokenType::Assignment &&
+			Left->IsEquivalent(context, *otherOperator->Left) &&
+			Right->IsEquivalent(context, *otherOperator->Right);
+	}
+	void BinaryOperatorNode::CollectPureCalls(std::vector<const FunctionCallNode*>& calls) const {
+		Left->CollectPureCalls(calls);
+		Right->CollectPureCalls(calls);
+	}
+
+	bool BinaryOperatorNode::IsAssociative() const noexcept {
+		// Integer addition and multiplication wrap around, so they are associative as well
+		return Operator == TokenType::Addition || Operator == TokenType::Multiplication;
+	}
+	bool BinaryOperatorNode::IsRightFirst() const noexcept {
+		if (Left->GetStackNeed() >= Right->GetStackNeed()) return false;
+
+		// Comparisons can be mirrored. Other operators need a swap, which is only done when the order is unobservable
+		if (IsComparison()) return true;
+		else return !Left->HasSideEffect() && !Right->HasSideEffect();
+	}
+	bool BinaryOperatorNode::IsComparison() const noexcept {
+		switch (Operator) {
+		case TokenType::Equivalence:
+		case TokenType::GreaterThan:
+		case TokenType::LessThan:
+		case TokenType::GreaterThanOrEqual:
+		case TokenType::LessThanOrEqual:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+	TypePtr BinaryOperatorNode::GetComputeType(const GeneratorContext& context) const {
+		if (IsBuiltinType(OperandType)->Size <= BuiltinType::Int->Size) return OperandType;
+
+		switch (Operator) {
+		case TokenType::Addition:
+		case TokenType::Subtraction:
+		case TokenType::Multiplication:
+			// These agree with the wider operation modulo 2^32, so only the result has to fit
+			if (Range::IsIn(EvaluateRange(context), BuiltinType::Int)) return BuiltinType::Int;
+			else return OperandType;
+
+		default:
+			if (!Range::IsIn(Range::Convert(Left->EvaluateRange(context), OperandType), BuiltinType::Int) ||
+				!Range::IsIn(Range::Convert(Right->EvaluateRange(context), OperandType), BuiltinType::Int)) return OperandType;
+
+			if (IsComparison() || Range::IsIn(EvaluateRange(context), BuiltinType::Int)) return BuiltinType::Int;
+			else return OperandType;
+		}
+	}
+	void BinaryOperatorNode::GenerateOperation(GeneratorContext& context, const TypePtr& computeType) const {
+		const bool isNarrowed = computeType != OperandType;
+		const auto& newLeftType = isNarrowed ? computeType : NewLeftType;
+		const auto& newRightType = isNarrowed ? computeType : NewRightType;
+		const auto isUnsigned = IsBuiltinType(computeType)->IsUnsigned();
+
+		if (IsAssociative()) {
+			std::vector<Operand> operands;
+			CollectOperands(operands);
+
+			// Constant operands anywhere in the chain are combined into one
+			std::optional<Constant> constant;
+
+			std::erase_if(operands, [&](const auto& operand) {
+				const auto value = operand.Expression->EvaluateConstant(context);
+				if (!value) return false;
+
+				constant = constant ?
+					Constant::Evaluate(Operator, *constant, value->Convert(computeType), computeType) :
+					value->Convert(computeType);
+
+				return true;
+			});
+
+			// Evaluating the deepest operand first keeps the chain at its minimal stack depth
+			std::stable_sort(operands.begin(), operands.end(), [](const auto& a, const auto& b) {
+				return a.StackNeed > b.StackNeed;
+			});
+
+			for (std::size_t i = 0; i <= operands.size(); ++i) {
+				if (i < operands.size()) {
+					operands[i].Expression->GenerateRValue(context, isNarrowed ? computeType : operands[i].NewType);
+				} else if (constant) {
+					constant->Generate(context);
+				} else break;
+
+				if (i == 0) continue;
+
+				if (Operator == TokenType::Addition) {
+					*context.Stream << u8"add\n";
+				} else {
+					*context.Stream << (isUnsigned ? u8"mul\n" : u8"imul\n");
+				}
 			}
+
+			return;
+		}
+
+		auto operator_ = Operator;
+
+		if (IsRightFirst()) {
+			Right->GenerateRValue(context, newRightType);
+			Left->GenerateRValue(context, newLeftType);
+
+			static const std::unordered_map<
+				TokenType,
+				TokenType> mirroredOperators{
+
+				{ TokenType::Equivalence, TokenType::Equivalence },
+				{ TokenType::GreaterThan, TokenType::LessThan },
+				{ TokenType::LessThan, TokenType::GreaterThan },
+				{ TokenType::GreaterThanOrEqual, TokenType::LessThanOrEqual },
+				{ TokenType::LessThanOrEqual, TokenType::GreaterThanOrEqual },
+			};
+
+			// A comparison is mirrored instead of restoring the operand order
+			if (const auto mirrorIter = mirroredOperators.find(Operator);
+				mirrorIter != mirroredOperators.end()) {
+
+				operator_ = mirrorIter->second;
+			} else {
+				*context.Stream << u8"swap\n";
 			}
+		} else {
+			Left->GenerateRValue(context, newLeftType);
+			Right->GenerateRValue(context, newRightType);
+		}
+
+		switch (operator_) {
+		case TokenType::Subtraction:
+			*context.Stream << u8"sub\n"; break;
+		case TokenType::Division:
+			*context.Stream << (isUnsigned ? u8"div\n" : u8"idiv\n"); break;
+		case TokenType::Modulo:
+			*context.Stream << (isUnsigned ? u8"mod\n" : u8"imod\n"); break;
+
+		case TokenType::Equivalence:
+		case TokenType::GreaterThan:
+		case TokenType::LessThan:
+		case TokenType::GreaterThanOrEqual:
+		case TokenType::LessThanOrEqual: {
+
+			const auto jumpLabelName = context.CreateTempIdentifier();
+			const auto doneLabelName = context.CreateTempIdentifier();
+
+			static const std::unordered_map<
+				TokenType,
+				std::u8string_view> jumpInstructions{
+
+				{ TokenType::Equivalence, u8"je" },
+				{ TokenType::GreaterThan, u8"ja" },
+				{ TokenType::LessThan, u8"jb" },
+				{ TokenType::GreaterThanOrEqual, u8"jae" },
+				{ TokenType::LessThanOrEqual, u8"jbe" },
+			};
+
+			*context.Stream <<
+				(isUnsigned ? u8"cmp\n" : u8"icmp\n") <<
+				jumpInstructions.at(operator_) << u8' ' << jumpLabelName << u8'\n' <<
+				u8"pop\n" <<
+				u8"push 0i\n" <<
+				u8"jmp " << doneLabelName << u8'\n' <<
+				jumpLabelName << u8":\n" <<
+				u8"push 1i\n" <<
+				doneLabelName << u8":\n";
+
+			break;
 		}
+
+		default:
+			assert(false);
 		}
 	}
+	void BinaryOperatorNode::CollectOperands(std::vector<Operand>& operands) const {
+		assert(IsAssociative());
+
+		const auto collect = [&](const std::unique_ptr<ExpressionNode>& operand, const TypePtr& newType) {
+			const auto binaryOperand = dynamic_cast<const BinaryOperatorNode*>(operand.get());
+
+			// An operand that is converted first computes in another type and cannot be merged into the chain
+			if (binaryOperand && binaryOperand->Operator == Operator && !newType &&
+				binaryOperand->Type->IsEqual(OperandType)) {
+
+				binaryOperand->CollectOperands(operands);
+			} else {
+				operands.push_back({
+					.Expression = operand.get(),
+					.NewType = newType,
+					.StackNeed = operand->GetStackNeed(),
+				});
+			}
+		};
+
+		collect(Left, NewLeftType);
+		collect(Right, NewRightType);
+	}
 }
 
 namespace chit {
@@ -203,14 +524,188 @@ namespace chit {
 		assert(Type);
 		assert(context.Stream);
 
-		for (const auto& argument : Arguments | std::views::reverse) {
-			argument->GenerateValue(context);
+		if (const auto slot = context.FindPureCall(this); slot) {
+			*context.Stream << u8"load " << context.Assembly.GetLocalIdentifier(*slot) << u8'\n';
+
+			return;
+		}
+
+		const auto definition = GetDefinition();
+
+		if (definition && definition->CanInline(context)) {
+			const auto arguments = EvaluateArguments(context, definition);
+
+			GenerateArguments(context, arguments);
+			definition->GenerateInline(context, arguments);
+		} else if (!definition || !GenerateSpecializedCall(context, definition)) {
+			GenerateArguments(context);
+
+			Function->GenerateFunctionCall(context);
+		}
+	}
+	std::optional<Constant> FunctionCallNode::EvaluateConstant(const GeneratorContext& context) const {
+		if (Type->IsVoid()) return std::nullopt;
+
+		// Functions that do not touch globals compute their result from the arguments alone, so it can be computed here
+		const auto definition = GetDefinition();
+		const auto effect = GetEffect();
+		if (!definition || !effect || effect->ReadsGlobals || effect->WritesGlobals) return std::nullopt;
+
+		std::vector<Constant> arguments;
+
+		for (std::size_t i = 0; i < Arguments.size(); ++i) {
+			const auto argument = Arguments[i]->EvaluateConstant(context);
+			if (!argument) return std::nullopt;
+
+			arguments.push_back(argument->Convert(definition->Prototype->Parameters[i].second->Type));
+		}
+
+		return definition->Evaluate(context, arguments);
+	}
+	std::size_t FunctionCallNode::GetStackNeed() const noexcept {
+		std::size_t need = 1;
+
+		// Arguments are pushed from the last one, and every pushed argument stays on the stack
+		for (std::size_t i = 0; i < Arguments.size(); ++i) {
+			need = std::max(need, Arguments[Arguments.size() - 1 - i]->GetStackNeed() + i);
+		}
+
+		return need;
+	}
+	bool FunctionCallNode::HasSideEffect() const noexcept {
+		if (const auto effect = GetEffect(); !effect || effect->HasSideEffect()) return true;
+
+		return std::any_of(Arguments.begin(), Arguments.end(), [](const auto& argument) {
+			return argument->HasSideEffect();
+		});
+	}
+	bool FunctionCallNode::IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const {
+		const auto otherCall = dynamic_cast<const FunctionCallNode*>(&other);
+		if (!otherCall || otherCall->Arguments.size() != Arguments.size()) return false;
+
+		// Only calls that are known to compute the same value from the same arguments are equivalent
+		if (HasSideEffect() || !Function->IsEquivalent(context, *otherCall->Function)) return false;
+
+		for (std::size_t i = 0; i < Arguments.size(); ++i) {
+			if (!Arguments[i]->IsEquivalent(context, *otherCall->Arguments[i])) return false;
+		}
+
+		return true;
+	}
+	void FunctionCallNode::CollectPureCalls(std::vector<const FunctionCallNode*>& calls) const {
+		for (const auto& argument : Arguments) {
+			argument->CollectPureCalls(calls);
+		}
+
+		if (!Type->IsVoid() && !HasSideEffect()) {
+			calls.push_back(this);
+		}
+	}
+	bool FunctionCallNode::GenerateTailCall(GeneratorContext& context) const {
+		assert(Type);
+		assert(context.Stream);
+
+		// ShitVM cannot replace the current frame, so only calls to the function being generated become jumps
+		if (!context.Function || GetDefinition() != context.Function->Definition) return false;
+
+		// A specialization can only loop back when the call passes the same constants again
+		const auto specialized = context.Function->Arguments;
+
+		if (!specialized.empty()) {
+			const auto arguments = EvaluateArguments(context, context.Function->Definition);
+
+			for (std::size_t i = 0; i < Arguments.size(); ++i) {
+				if (specialized[i] && arguments[i] != specialized[i]) return false;
+			}
+		}
+
+		GenerateArguments(context, specialized);
 
-			if (argument->IsLValue) {
-				*context.Stream << u8"tload\n";
+		// Every argument is evaluated before any parameter is overwritten. Parameters own the first slots
+		for (std::size_t i = 0, slot = 0; i < Arguments.size(); ++i) {
+			if (specialized.empty() || !specialized[i]) {
+				*context.Stream << u8"store " << context.Assembly.GetLocalIdentifier(slot++) << u8'\n';
 			}
 		}
 
-		Function->GenerateFunctionCall(context);
+		*context.Stream << u8"jmp " << context.Function->EntryLabel << u8'\n';
+
+		context.Function->IsEntryLabelUsed = true;
+
+		return true;
+	}
+
+	std::optional<Effect> FunctionCallNode::GetEffect() const noexcept {
+		const auto callee = dynamic_cast<const IdentifierNode*>(Function.get());
+		if (!callee) return std::nullopt;
+
+		if (const auto symbol = IsFunctionSymbol(callee->Symbol); symbol) return symbol->Effect;
+		else return std::nullopt;
+	}
+	const FunctionDefinitionNode* FunctionCallNode::GetDefinition() const noexcept {
+		const auto callee = dynamic_cast<const IdentifierNode*>(Function.get());
+		if (!callee) return nullptr;
+
+		const auto symbol = IsFunctionSymbol(callee->Symbol);
+		if (!symbol || !symbol->Definition) return nullptr;
+
+		// A call that does not match the definition is left to the VM
+		if (Arguments.size() != symbol->Definition->Prototype->Parameters.size()) return nullptr;
+		else return symbol->Definition;
+	}
+	void FunctionCallNode::GenerateArguments(
+		GeneratorContext& context,
+		std::span<const std::optional<Constant>> skipped) const {
+
+		const auto& parameterTypes = IsFunctionType(Function->Type)->ParameterTypes;
+
+		for (std::size_t i = Arguments.size(); i-- > 0;) {
+			if (!skipped.empty() && skipped[i]) continue;
+
+			Arguments[i]->GenerateRValue(context, i < parameterTypes.size() ? parameterTypes[i] : nullptr);
+		}
+	}
+	std::vector<std::optional<Constant>> FunctionCallNode::EvaluateArguments(
+		const GeneratorContext& context,
+		const FunctionDefinitionNode* definition) const {
+
+		std::vector<std::optional<Constant>> arguments;
+
+		// Only a parameter that is never assigned can be replaced by its argument everywhere
+		for (std::size_t i = 0; i < Arguments.size(); ++i) {
+			const auto symbol = definition->GetParameterSymbol(i);
+			const auto constant = Arguments[i]->EvaluateConstant(context);
+
+			if (symbol && !symbol->IsModified && constant) {
+				arguments.push_back(constant->Convert(definition->Prototype->Parameters[i].second->Type));
+			} else {
+				arguments.push_back(std::nullopt);
+			}
+		}
+
+		return arguments;
+	}
+	bool FunctionCallNode::GenerateSpecializedCall(
+		GeneratorContext& context,
+		const FunctionDefinitionNode* definition) const {
+
+		if (!context.Function || context.Function->IsMeasuring) return false;
+
+		const auto arguments = EvaluateArguments(context, definition);
+		if (std::none_of(arguments.begin(), arguments.end(), [](const auto& argument) { return argument.has_value(); })) return false;
+
+		// Within a clone, a recursive call with other constants would otherwise be cloned again for every level of the recursion
+		if (const auto& specialized = context.Function->Arguments;
+			context.Function->Definition == definition && !specialized.empty() &&
+			!std::equal(arguments.begin(), arguments.end(), specialized.begin(), specialized.end())) return false;
+
+		const auto name = definition->GetSpecialization(context, arguments);
+		if (!name) return false;
+
+		GenerateArguments(context, arguments);
+
+		*context.Stream << u8"call " << *name << u8'\n';
+
+		return true;
 	}
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include <chit/ast/Node.hpp>
 
 #include <chit/Generator.hpp>
+#include <chit/ast/Declaration.hpp>
+#include <chit/ast/Expression.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace chit {
@@ -11,6 +14,139 @@ namespace chit {
 	void ExpressionNode::GenerateFunctionCall(GeneratorContext&) const {
 		assert(false);
 	}
+	bool ExpressionNode::GenerateTailCall(GeneratorContext&) const {
+		return false;
+	}
+	bool ExpressionNode::GenerateNarrowValue(GeneratorContext&) const {
+		return false;
+	}
+	std::optional<Constant> ExpressionNode::EvaluateConstant(const GeneratorContext&) const {
+		return std::nullopt;
+	}
+	std::optional<Range> ExpressionNode::EvaluateRange(const GeneratorContext& context) const {
+		const auto builtinType = IsBuiltinType(Type);
+		if (!builtinType || !builtinType->Rank) return std::nullopt;
+
+		if (const auto constant = EvaluateConstant(context); constant) {
+			// Unsigned 64-bit values above the signed maximum have no range
+			if (builtinType->IsUnsigned() && constant->GetSigned() < 0) return std::nullopt;
+			else return Range{ .Min = constant->GetSigned(), .Max = constant->GetSigned() };
+		}
+
+		return Range::GetTypeRange(Type);
+	}
+	std::optional<bool> ExpressionNode::PredictCondition(const GeneratorContext&) const {
+		return std::nullopt;
+	}
+	std::size_t ExpressionNode::GetStackNeed() const noexcept {
+		return 1;
+	}
+	bool ExpressionNode::HasSideEffect() const noexcept {
+		return false;
+	}
+	bool ExpressionNode::IsEquivalent(const GeneratorContext& context, const ExpressionNode& other) const {
+		const auto constant = EvaluateConstant(context);
+		const auto otherConstant = other.EvaluateConstant(context);
+
+		return constant && otherConstant && *constant == *otherConstant;
+	}
+	void ExpressionNode::CollectPureCalls(std::vector<const FunctionCallNode*>&) const {}
+
+	void ExpressionNode::GenerateRValue(GeneratorContext& context, const TypePtr& type) const {
+		assert(Type);
+		assert(context.Stream);
+
+		const auto& resultType = type ? type : Type;
+
+		if (const auto constant = EvaluateConstant(context); constant) {
+			constant->Convert(resultType).Generate(context);
+
+			return;
+		}
+
+		if (GenerateSharedRValue(context, resultType)) return;
+
+		// A 64-bit value that is truncated anyway may be computed in 32 bits
+		const auto builtinResultType = IsBuiltinType(resultType);
+		const auto builtinType = IsBuiltinType(Type);
+
+		if (builtinResultType && builtinResultType->Size == BuiltinType::Int->Size &&
+			builtinType && builtinType->Size > BuiltinType::Int->Size && GenerateNarrowValue(context)) return;
+
+		GenerateValue(context);
+
+		if (IsLValue) {
+			*context.Stream << u8"tload\n";
+		}
+		if (!resultType->IsEqual(Type)) {
+			resultType->GenerateConvert(context, Type);
+		}
+	}
+}
+
+namespace chit {
+	bool ExpressionNode::GenerateSharedRValue(GeneratorContext& context, const TypePtr& type) const {
+		// Nothing in an expression without side effects can change the arguments of its calls
+		if (!context.Frame || HasSideEffect()) return false;
+
+		std::vector<const FunctionCallNode*> calls;
+		CollectPureCalls(calls);
+
+		// Identical pure calls are evaluated once, into a slot. Calls already shared by an enclosing expression are skipped
+		std::vector<const FunctionCallNode*> sharedCalls;
+
+		for (std::size_t i = 0; i < calls.size(); ++i) {
+			const auto isEquivalent = [&](const FunctionCallNode* call) {
+				return call->IsEquivalent(context, *calls[i]);
+			};
+
+			if (context.FindPureCall(calls[i]) ||
+				std::any_of(sharedCalls.begin(), sharedCalls.end(), isEquivalent) ||
+				std::none_of(calls.begin() + i + 1, calls.end(), isEquivalent)) continue;
+
+			sharedCalls.push_back(calls[i]);
+		}
+
+		if (sharedCalls.empty()) return false;
+
+		GeneratorContext sharedContext{
+			.Parent = &context,
+			.Assembly = context.Assembly,
+			.Profile = context.Profile,
+			.Stream = context.Stream,
+			.Frame = context.Frame,
+			.Function = context.Function,
+			.InlinedFunction = context.InlinedFunction,
+			.Messages = context.Messages,
+		};
+
+		for (const auto call : sharedCalls) {
+			call->GenerateValue(sharedContext);
+
+			const auto slot = context.Frame->AllocateSlot(call->Type);
+
+			*context.Stream << u8"store " << context.Assembly.GetLocalIdentifier(slot) << u8'\n';
+
+			sharedContext.PureCalls.push_back({ call, slot });
+		}
+
+		GenerateRValue(sharedContext, type);
+
+		for (const auto& [call, slot] : sharedContext.PureCalls) {
+			context.Frame->FreeSlot(slot);
+		}
+
+		return true;
+	}
+}
+
+namespace chit {
+	bool StatementNode::AlwaysReturns(const GeneratorContext&) const {
+		return false;
+	}
+	std::optional<Completion> StatementNode::Execute(GeneratorContext&) const {
+		return std::nullopt;
+	}
 }
 
 namespace chit {
@@ -18,6 +154,26 @@ namespace chit {
 		for (auto& statement : Statements) {
 			statement->Generate(context);
 		}
+
+		// Clones requested while generating are generated afterwards, and may request further clones themselves
+		for (bool isGenerated = true; isGenerated;) {
+			isGenerated = false;
+
+			for (auto& statement : Statements) {
+				auto definition = dynamic_cast<const FunctionDefinitionNode*>(statement.get());
+
+				// A declaration bound to another unit's definition gets that definition's clones generated here
+				if (const auto declaration = dynamic_cast<const FunctionDeclarationNode*>(statement.get());
+					declaration && declaration->Symbol) {
+
+					definition = declaration->Symbol->Definition;
+				}
+
+				if (definition) {
+					isGenerated |= definition->GenerateSpecializations(context);
+				}
+			}
+		}
 	}
 }
 
@@ -28,12 +184,46 @@ namespace chit {
 		GeneratorContext blockContext{
 			.Parent = &context,
 			.Assembly = context.Assembly,
+			.Profile = context.Profile,
 			.Stream = context.Stream,
+			.Frame = context.Frame,
+			.Function = context.Function,
 			.Messages = context.Messages,
 		};
 
 		for (auto& statement : Statements) {
 			statement->Generate(blockContext);
+
+			// The remaining statements are unreachable
+			if (!blockContext.GetFlow().IsReachable) break;
 		}
+
+		// Slots of this block's variables can be reused by the following sibling blocks
+		blockContext.DeleteLocals();
+	}
+	bool BlockNode::AlwaysReturns(const GeneratorContext& context) const {
+		return std::any_of(Statements.begin(), Statements.end(), [&](const auto& statement) {
+			return statement->AlwaysReturns(context);
+		});
+	}
+	std::optional<Completion> BlockNode::Execute(GeneratorContext& context) const {
+		assert(context.Interpreter);
+
+		if (!context.Interpreter->Step()) return std::nullopt;
+
+		GeneratorContext blockContext{
+			.Parent = &context,
+			.Assembly = context.Assembly,
+			.Interpreter = context.Interpreter,
+			.Messages = context.Messages,
+		};
+
+		for (auto& statement : Statements) {
+			const auto completion = statement->Execute(blockContext);
+
+			if (!completion || completion->IsReturn) return completion;
+		}
+
+		return Completion{};
 	}
 }
\ No newline at end of file
@@ -1,39 +1,81 @@
 #include <chit/ast/Statement.hpp>
 
 #include <chit/Generator.hpp>
+#include <chit/ast/Declaration.hpp>
+#include <chit/ast/Expression.hpp>
 
 #include <cassert>
+#include <utility>
 
 namespace chit {
 	void EmptyStatementNode::Generate(GeneratorContext&) const {}
+	std::optional<Completion> EmptyStatementNode::Execute(GeneratorContext&) const {
+		return Completion{};
+	}
 }
 
 namespace chit {
 	void ExpressionStatementNode::Generate(GeneratorContext& context) const {
 		assert(context.Stream);
 
+		// The value is discarded, so an expression without side effects or with a known value needs no evaluation at all
+		if (!Expression->HasSideEffect() || Expression->EvaluateConstant(context)) return;
+
 		Expression->GenerateValue(context);
 
 		if (!Expression->Type->IsVoid()) {
 			*context.Stream << u8"pop\n";
 		}
 	}
+	std::optional<Completion> ExpressionStatementNode::Execute(GeneratorContext& context) const {
+		assert(context.Interpreter);
+
+		if (!context.Interpreter->Step()) return std::nullopt;
+
+		// Assignments to variables are the only statements that change the state of the interpreter
+		if (const auto assignment = dynamic_cast<const BinaryOperatorNode*>(Expression.get());
+			assignment && assignment->Operator == TokenType::Assignment) {
+
+			const auto identifier = dynamic_cast<const IdentifierNode*>(assignment->Left.get());
+			const auto symbol = identifier ? IsVariableSymbol(identifier->Symbol) : nullptr;
+			const auto value = assignment->Right->EvaluateConstant(context);
+
+			if (!symbol || !value || !context.AssignConstant(symbol, value->Convert(assignment->Left->Type))) return std::nullopt;
+			else return Completion{};
+		}
+
+		if (!Expression->HasSideEffect() || Expression->EvaluateConstant(context)) return Completion{};
+		else return std::nullopt;
+	}
 }
 
 namespace chit {
 	void ReturnNode::Generate(GeneratorContext& context) const {
 		assert(context.Stream);
 
-		Expression->GenerateValue(context);
+		if (!Expression->GenerateTailCall(context)) {
+			Expression->GenerateRValue(context, FunctionReturnType);
 
-		if (Expression->IsLValue) {
-			*context.Stream << u8"tload\n";
-		}
-		if (!FunctionReturnType->IsEqual(Expression->Type)) {
-			FunctionReturnType->GenerateConvert(context);
+			*context.Stream << u8"ret\n";
 		}
 
-		*context.Stream << u8"ret\n";
+		context.GetFlow().IsReachable = false;
+	}
+	bool ReturnNode::AlwaysReturns(const GeneratorContext&) const {
+		return true;
+	}
+	std::optional<Completion> ReturnNode::Execute(GeneratorContext& context) const {
+		assert(context.Interpreter);
+
+		if (!context.Interpreter->Step()) return std::nullopt;
+
+		const auto value = Expression->EvaluateConstant(context);
+		if (!value) return std::nullopt;
+
+		return Completion{
+			.IsReturn = true,
+			.Value = value->Convert(FunctionReturnType),
+		};
 	}
 }
 
@@ -41,28 +83,130 @@ namespace chit {
 	void IfNode::Generate(GeneratorContext& context) const {
 		assert(context.Stream);
 
-		Condition->GenerateValue(context);
+		// Only the branch that is taken is generated
+		if (const auto condition = Condition->EvaluateConstant(context); condition) {
+			if (!condition->IsZero()) {
+				Body->Generate(context);
+			} else if (ElseBody) {
+				ElseBody->Generate(context);
+			}
+
+			return;
+		}
+
+		Condition->GenerateRValue(context);
+
+		// The likely branch falls through. An unlikely branch is moved out of line, to the end of the function
+		const auto prediction = PredictBody(context);
+
+		if (prediction == false) {
+			GenerateBranches(context, u8"jne", ElseBody.get(), Body.get(), true);
+		} else {
+			GenerateBranches(context, u8"je", Body.get(), ElseBody.get(), prediction.has_value());
+		}
+	}
+	bool IfNode::AlwaysReturns(const GeneratorContext& context) const {
+		if (const auto condition = Condition->EvaluateConstant(context); condition) {
+			const auto& body = condition->IsZero() ? ElseBody : Body;
+
+			return body && body->AlwaysReturns(context);
+		}
+
+		return ElseBody && Body->AlwaysReturns(context) && ElseBody->AlwaysReturns(context);
+	}
+	std::optional<Completion> IfNode::Execute(GeneratorContext& context) const {
+		assert(context.Interpreter);
+
+		if (!context.Interpreter->Step()) return std::nullopt;
+
+		const auto condition = Condition->EvaluateConstant(context);
+		if (!condition) return std::nullopt;
 
-		if (Condition->IsLValue) {
-			*context.Stream << u8"tload\n";
+		if (!condition->IsZero()) return Body->Execute(context);
+		else if (ElseBody) return ElseBody->Execute(context);
+		else return Completion{};
+	}
+	std::optional<bool> IfNode::PredictBody(const GeneratorContext& context) const {
+		// Measured counts take precedence over any heuristic
+		if (context.Profile && context.Function) {
+			const auto count = context.Profile->GetBranchCount(
+				context.Function->Definition->Prototype->Name,
+				BranchIndex);
+
+			if (count && count->Then != count->Else) return count->Then > count->Else;
 		}
 
+		if (const auto prediction = Condition->PredictCondition(context); prediction) return prediction;
+
+		// Ball-Larus return heuristic: a branch that leaves the function is the unlikely one
+		const bool bodyReturns = Body->AlwaysReturns(context);
+		const bool elseBodyReturns = ElseBody && ElseBody->AlwaysReturns(context);
+
+		if (bodyReturns != elseBodyReturns) return elseBodyReturns;
+		else return std::nullopt;
+	}
+	void IfNode::GenerateBranches(
+		GeneratorContext& context,
+		std::u8string_view jump,
+		const StatementNode* fallthrough,
+		const StatementNode* target,
+		bool isTargetCold) const {
+
 		const auto jumpLabelName = context.CreateTempIdentifier();
-		const auto doneLabelName = context.CreateTempIdentifier();
 
 		*context.Stream <<
-			u8"jne " << jumpLabelName << u8'\n' <<
+			jump << u8' ' << jumpLabelName << u8'\n' <<
 			u8"pop\n";
 
-		if (ElseBody) {
-			ElseBody->Generate(context);
+		// Each branch starts from the state before the condition was tested, and the states meet after the if statement
+		auto& flow = context.GetFlow();
+		auto targetFlow = flow;
+
+		if (fallthrough) {
+			fallthrough->Generate(context);
 		}
 
-		*context.Stream <<
-			u8"jmp " << doneLabelName << u8'\n' <<
-			jumpLabelName << u8":\n";
+		if (!target) {
+			*context.Stream << jumpLabelName << u8":\n";
+
+			flow.Merge(std::move(targetFlow));
+
+			return;
+		}
+
+		std::swap(flow, targetFlow);
+
+		const auto doneLabelName = context.CreateTempIdentifier();
+
+		if (isTargetCold && context.Function) {
+			BodyStream coldBlock;
+			GeneratorContext coldContext{
+				.Parent = &context,
+				.Assembly = context.Assembly,
+				.Profile = context.Profile,
+				.Stream = &coldBlock,
+				.Frame = context.Frame,
+				.Function = context.Function,
+				.InlinedFunction = context.InlinedFunction,
+				.Messages = context.Messages,
+			};
+
+			coldBlock << jumpLabelName << u8":\n";
+
+			target->Generate(coldContext);
+
+			coldBlock << u8"jmp " << doneLabelName << u8'\n';
+
+			context.Function->ColdBlocks << coldBlock.view();
+		} else {
+			*context.Stream <<
+				u8"jmp " << doneLabelName << u8'\n' <<
+				jumpLabelName << u8":\n";
+
+			target->Generate(context);
+		}
 
-		Body->Generate(context);
+		flow.Merge(std::move(targetFlow));
 
 		*context.Stream << doneLabelName << u8":\n";
 	}
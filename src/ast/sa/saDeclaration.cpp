@@ -19,7 +19,11 @@ namespace chit {
 			ReturnType->Type,
 			std::move(parameterTypes)));
 		if (!Symbol) {
-			// TODO: Error or ignore
+			context.Messages.push_back({
+				.Type = MessageType::Error,
+				.Data = u8"Conflicting types for '" + std::u8string(Name) + u8"'",
+				.Offset = NameOffset,
+			});
 		}
 	}
 }
@@ -32,21 +36,44 @@ namespace chit {
 
 		Prototype->Analyze(context);
 
+		if (Prototype->Symbol) {
+			Prototype->Symbol->Definition = this;
+		}
+
 		ParserContext = std::unique_ptr<chit::ParserContext>(new chit::ParserContext{
 			.Messages = context.Messages,
 			.SymbolTable = SymbolTable(context.SymbolTable),
 			.FunctionReturnType = Prototype->ReturnType->Type,
+			.Function = this,
 		});
 
 		for (const auto& parameter : Prototype->Parameters) {
-			ParserContext->SymbolTable.CreateVariableSymbol(
+			const auto symbol = IsVariableSymbol(ParserContext->SymbolTable.CreateVariableSymbol(
 				parameter.first,
 				parameter.second->Type,
 				VariableState::Initalized
-			);
+			));
+
+			if (symbol) {
+				Assignment.Declare(symbol, true);
+			}
 		}
 
 		Body->Analyze(*ParserContext);
+
+		// Only variables that some read may find unassigned are reported, with the weakest state any read saw
+		for (const auto variable : Variables) {
+			if (!Assignment.IsWeakened(variable->Symbol)) continue;
+
+			const auto isUninitialized = variable->Symbol->State == VariableState::Uninitialized;
+
+			context.Messages.push_back({
+				.Type = MessageType::Warning,
+				.Data = u8"'" + std::u8string(variable->Name) + (isUninitialized ?
+					u8"' is used uninitialized" : u8"' may be used uninitialized"),
+				.Offset = variable->NameOffset,
+			});
+		}
 	}
 }
 
@@ -68,6 +95,9 @@ namespace chit {
 
 		if (!Symbol) {
 			// TODO: Error or ignore
+		} else if (context.Function) {
+			context.Function->Assignment.Declare(Symbol, static_cast<bool>(Initializer));
+			context.Function->Variables.push_back(this);
 		}
 	}
 }
\ No newline at end of file
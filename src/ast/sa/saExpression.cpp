@@ -2,9 +2,17 @@
 
 #include <chit/Parser.hpp>
 #include <chit/Type.hpp>
+#include <chit/ast/Declaration.hpp>
 
 namespace chit {
 	void IdentifierNode::Analyze(ParserContext& context) const {
+		Resolve(context);
+
+		if (const auto varSymbol = IsVariableSymbol(Symbol); varSymbol && context.Function) {
+			context.Function->Assignment.Read(varSymbol);
+		}
+	}
+	void IdentifierNode::Resolve(ParserContext& context) const {
 		if (const auto symbol = context.SymbolTable.FindSymbol(Name);
 			symbol) {
 
@@ -15,6 +23,10 @@ namespace chit {
 				IsLValue = true;
 
 				Symbol = symbol->first;
+
+				if (varSymbol->IsGlobal && context.Function) {
+					context.Function->LocalEffect.ReadsGlobals = true;
+				}
 			} else if (const auto funcSymbol = IsFunctionSymbol(symbol->first);
 					   funcSymbol) {
 
@@ -73,7 +85,16 @@ namespace chit {
 
 namespace chit {
 	void BinaryOperatorNode::Analyze(ParserContext& context) const {
-		Left->Analyze(context);
+		const auto target = Operator == TokenType::Assignment ?
+			dynamic_cast<const IdentifierNode*>(Left.get()) : nullptr;
+
+		// The target of an assignment is written, not read
+		if (target) {
+			target->Resolve(context);
+		} else {
+			Left->Analyze(context);
+		}
+
 		Right->Analyze(context);
 
 		// TODO: Type checking
@@ -84,6 +105,19 @@ namespace chit {
 				// TODO: Error
 			}
 
+			if (target) {
+				if (const auto varSymbol = IsVariableSymbol(target->Symbol); varSymbol) {
+					varSymbol->IsModified = true;
+
+					if (varSymbol->IsGlobal && context.Function) {
+						context.Function->LocalEffect.WritesGlobals = true;
+					}
+					if (context.Function) {
+						context.Function->Assignment.Assign(varSymbol);
+					}
+				}
+			}
+
 			if (!Left->Type->IsEqual(Right->Type)) {
 				// TODO: Type checking
 
@@ -93,6 +127,8 @@ namespace chit {
 			Type = Left->Type;
 			IsLValue = false;
 
+			break;
+
 		case TokenType::Addition:
 		case TokenType::Subtraction:
 		case TokenType::Multiplication:
@@ -129,6 +165,10 @@ namespace chit {
 				IsLValue = false;
 			}
 
+			if (MayTrap() && context.Function) {
+				context.Function->LocalEffect.MayTrap = true;
+			}
+
 			break;
 		}
 	}
@@ -144,5 +184,16 @@ namespace chit {
 
 		Type = IsFunctionType(Function->Type)->ReturnType;
 		IsLValue = false;
+
+		// Callees are recorded by name, since they may be defined in another unit
+		if (context.Function) {
+			const auto callee = dynamic_cast<const IdentifierNode*>(Function.get());
+
+			if (callee && IsFunctionSymbol(callee->Symbol)) {
+				context.Function->Callees.push_back(callee->Name);
+			} else {
+				context.Function->LocalEffect |= Effect::GetUnknown();
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -17,6 +17,7 @@ namespace chit {
 			.Messages = context.Messages,
 			.SymbolTable = SymbolTable(context.SymbolTable),
 			.FunctionReturnType = context.FunctionReturnType,
+			.Function = context.Function,
 		});
 
 		for (auto& statement : Statements) {
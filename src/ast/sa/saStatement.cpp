@@ -1,6 +1,10 @@
 #include <chit/ast/Statement.hpp>
 
 #include <chit/Parser.hpp>
+#include <chit/ast/Declaration.hpp>
+
+#include <cassert>
+#include <utility>
 
 namespace chit {
 	void EmptyStatementNode::Analyze(ParserContext&) const {}
@@ -19,19 +23,37 @@ namespace chit {
 		// TODO: Type checking
 
 		FunctionReturnType = context.FunctionReturnType;
+
+		if (context.Function) {
+			context.Function->Assignment.Terminate();
+		}
 	}
 }
 
 namespace chit {
 	void IfNode::Analyze(ParserContext& context) const {
+		assert(context.Function);
+
+		// Branches are numbered in source order, which is how a profile refers to them
+		BranchIndex = context.Function->BranchCount++;
+
 		Condition->Analyze(context);
 
 		// TODO: Type checking
 
+		auto& assignment = context.Function->Assignment;
+		const auto state = assignment.Save();
+
 		Body->Analyze(context);
 
+		// Both branches start from the state after the condition and join afterwards
+		auto bodyState = assignment.Save();
+		assignment.Restore(state);
+
 		if (ElseBody) {
 			ElseBody->Analyze(context);
 		}
+
+		assignment.Merge(std::move(bodyState));
 	}
 }
\ No newline at end of file
@@ -2,122 +2,156 @@
 
 #include <chit/util/String.hpp>
 
-#include <algorithm>
 #include <cassert>
 
 namespace chit {
-	JsonValue JsonNull() noexcept {
-		return std::monostate{};
-	}
+	JsonWriter::JsonWriter(std::basic_ostream<char8_t>& stream, bool isPretty) noexcept
+		: m_Stream(stream), m_IsPretty(isPretty) {}
 
-	std::basic_ostream<char8_t>& operator<<(
-		std::basic_ostream<char8_t>& stream,
-		const JsonValue& value) {
-
-		if (std::holds_alternative<std::monostate>(value)) {
-			return stream << u8"null";
-		} else if (std::holds_alternative<std::u8string>(value)) {
-			return stream << u8'"' << std::get<std::u8string>(value) << u8'"';
-		} else if (std::holds_alternative<std::int64_t>(value)) {
-			return stream << ToUtf8String(std::get<std::int64_t>(value));
-		} else if (std::holds_alternative<std::uint64_t>(value)) {
-			return stream << ToUtf8String(std::get<std::uint64_t>(value));
-		} else if (std::holds_alternative<bool>(value)) {
-			return stream << (std::get<bool>(value) ? u8"true" : u8"false");
-		} else if (std::holds_alternative<std::unique_ptr<JsonArray>>(value)) {
-			return stream << *std::get<std::unique_ptr<JsonArray>>(value);
-		} else {
-			return stream << *std::get<std::unique_ptr<JsonObject>>(value);
-		}
+	JsonWriter& JsonWriter::BeginObject() {
+		BeginContainer(u8'{');
+
+		return *this;
 	}
-}
+	JsonWriter& JsonWriter::EndObject() {
+		EndContainer(u8'}');
 
-namespace chit {
-	JsonArray::JsonArray(std::vector<JsonValue> elements) noexcept
-		: m_Elements(std::move(elements)) {}
+		return *this;
+	}
+	JsonWriter& JsonWriter::BeginArray() {
+		BeginContainer(u8'[');
 
-	JsonArray& JsonArray::AddElement(JsonValue value) {
-		m_Elements.push_back(std::move(value));
+		return *this;
+	}
+	JsonWriter& JsonWriter::EndArray() {
+		EndContainer(u8']');
 
 		return *this;
 	}
-	JsonValue JsonArray::Build() {
-		return std::unique_ptr<JsonArray>(new JsonArray(std::move(*this)));
+	JsonWriter& JsonWriter::Key(std::u8string_view name) {
+		assert(!name.empty());
+		assert(m_Depth > 0);
+		assert(!m_HasKey);
+
+		BeginValue();
+		WriteEscaped(name);
+
+		m_Stream << (m_IsPretty ? u8": " : u8":");
+		m_HasKey = true;
+
+		return *this;
 	}
 
-	std::basic_ostream<char8_t>& operator<<(
-		std::basic_ostream<char8_t>& stream,
-		const JsonArray& array) {
+	JsonWriter& JsonWriter::Null() {
+		BeginValue();
 
-		stream << u8'[';
+		m_Stream << u8"null";
 
-		bool isFirst = true;
+		return *this;
+	}
+	JsonWriter& JsonWriter::String(std::u8string_view value) {
+		BeginValue();
+		WriteEscaped(value);
 
-		for (const auto& element : array.m_Elements) {
-			if (!isFirst) {
-				stream << u8',';
-			} else {
-				isFirst = false;
-			}
+		return *this;
+	}
+	JsonWriter& JsonWriter::Integer(std::int64_t value) {
+		BeginValue();
+		m_Stream << ToUtf8Chars(value);
 
-			stream << element;
-		}
+		return *this;
+	}
+	JsonWriter& JsonWriter::Integer(std::uint64_t value) {
+		BeginValue();
+		m_Stream << ToUtf8Chars(value);
 
-		return stream << u8']';
+		return *this;
 	}
-}
+	JsonWriter& JsonWriter::Boolean(bool value) {
+		BeginValue();
 
-namespace chit {
-	JsonObject& JsonObject::SetField(std::u8string name, JsonValue value) {
-		assert(!name.empty());
-		
-		if (const auto fieldIter =
-				std::find_if(m_Fields.begin(), m_Fields.end(), [&name](const auto& field) {
-					return field.first == name;
-				});
-			fieldIter != m_Fields.end()) {
-
-			fieldIter->second = std::move(value);
+		m_Stream << (value ? u8"true" : u8"false");
+
+		return *this;
+	}
+
+	void JsonWriter::BeginValue() {
+		if (m_HasKey) {
+			m_HasKey = false;
 		} else {
-			m_Fields.push_back({ std::move(name), std::move(value) });
+			if (!m_IsFirst) {
+				m_Stream << u8',';
+			}
+			if (m_Depth > 0) {
+				WriteIndent();
+			}
 		}
 
-		return *this;
+		m_IsFirst = false;
 	}
-	JsonObject& JsonObject::Merge(JsonValue&& value) {
-		assert(std::holds_alternative<std::unique_ptr<JsonObject>>(value));
+	void JsonWriter::BeginContainer(char8_t bracket) {
+		BeginValue();
 
-		auto& valueObject = *std::get<std::unique_ptr<JsonObject>>(value);
+		m_Stream << bracket;
 
-		for (auto& [name, fieldValue] : valueObject.m_Fields) {
-			SetField(std::move(name), std::move(fieldValue));
+		++m_Depth;
+		m_IsFirst = true;
+	}
+	void JsonWriter::EndContainer(char8_t bracket) {
+		assert(m_Depth > 0);
+		assert(!m_HasKey);
+
+		--m_Depth;
+
+		if (!m_IsFirst) {
+			WriteIndent();
 		}
 
-		return *this;
+		m_Stream << bracket;
+		m_IsFirst = false;
 	}
-	JsonValue JsonObject::Build() {
-		return std::unique_ptr<JsonObject>(new JsonObject(std::move(*this)));
+	void JsonWriter::WriteIndent() {
+		if (!m_IsPretty)
+			return;
+
+		m_Stream << u8'\n';
+
+		for (std::size_t i = 0; i < m_Depth; ++i) {
+			m_Stream << u8'\t';
+		}
 	}
+	void JsonWriter::WriteEscaped(std::u8string_view string) {
+		static constexpr char8_t hexDigits[] = u8"0123456789abcdef";
 
-	std::basic_ostream<char8_t>& operator<<(
-		std::basic_ostream<char8_t>& stream,
-		const JsonObject& object) {
+		m_Stream << u8'"';
 
-		stream << u8'{';
+		std::size_t begin = 0;
 
-		bool isFirst = true;
+		for (std::size_t i = 0; i < string.size(); ++i) {
+			const char8_t c = string[i];
+			if (c >= 0x20 && c != u8'"' && c != u8'\\')
+				continue;
 
-		for (const auto& [name, value] : object.m_Fields) {
-			if (!isFirst) {
-				stream << u8',';
-			} else {
-				isFirst = false;
-			}
+			m_Stream.write(string.data() + begin, i - begin);
+			begin = i + 1;
+
+			switch (c) {
+			case u8'"': m_Stream << u8"\\\""; break;
+			case u8'\\': m_Stream << u8"\\\\"; break;
+			case u8'\b': m_Stream << u8"\\b"; break;
+			case u8'\f': m_Stream << u8"\\f"; break;
+			case u8'\n': m_Stream << u8"\\n"; break;
+			case u8'\r': m_Stream << u8"\\r"; break;
+			case u8'\t': m_Stream << u8"\\t"; break;
+
+			default:
+				m_Stream << u8"\\u00" << hexDigits[c >> 4] << hexDigits[c & 0xF];
 
-			stream << u8'"' << name << u8"\":";
-			stream << value;
+				break;
+			}
 		}
 
-		return stream << u8'}';
+		m_Stream.write(string.data() + begin, string.size() - begin);
+		m_Stream << u8'"';
 	}
-}
\ No newline at end of file
+}
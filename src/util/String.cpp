@@ -1,20 +1,60 @@
 #include <chit/util/String.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+
+namespace chit {
+	namespace {
+		template<typename T>
+		IntegerChars ToUtf8CharsImpl(T integer) noexcept {
+			char buffer[20];
+			IntegerChars result;
+
+			const auto end = std::to_chars(std::begin(buffer), std::end(buffer), integer).ptr;
+
+			result.Size = static_cast<std::size_t>(std::copy(buffer, end, result.Data) - result.Data);
+
+			return result;
+		}
+	}
+
+	std::u8string_view IntegerChars::GetView() const noexcept {
+		return { Data, Size };
+	}
+
+	IntegerChars ToUtf8Chars(std::int32_t integer) noexcept {
+		return ToUtf8CharsImpl(integer);
+	}
+	IntegerChars ToUtf8Chars(std::uint32_t integer) noexcept {
+		return ToUtf8CharsImpl(integer);
+	}
+	IntegerChars ToUtf8Chars(std::int64_t integer) noexcept {
+		return ToUtf8CharsImpl(integer);
+	}
+	IntegerChars ToUtf8Chars(std::uint64_t integer) noexcept {
+		return ToUtf8CharsImpl(integer);
+	}
+
+	std::basic_ostream<char8_t>& operator<<(
+		std::basic_ostream<char8_t>& stream,
+		const IntegerChars& chars) {
+
+		return stream.write(chars.Data, static_cast<std::streamsize>(chars.Size));
+	}
+}
+
 namespace chit {
 	std::u8string ToUtf8String(std::int32_t integer) {
-		return ToUtf8String(static_cast<std::int64_t>(integer));
+		return std::u8string(ToUtf8Chars(integer).GetView());
 	}
 	std::u8string ToUtf8String(std::uint32_t integer) {
-		return ToUtf8String(static_cast<std::uint64_t>(integer));
+		return std::u8string(ToUtf8Chars(integer).GetView());
 	}
 	std::u8string ToUtf8String(std::int64_t integer) {
-		const auto temp = std::to_string(integer);
-
-		return { temp.begin(), temp.end() };
+		return std::u8string(ToUtf8Chars(integer).GetView());
 	}
 	std::u8string ToUtf8String(std::uint64_t integer) {
-		const auto temp = std::to_string(integer);
-
-		return { temp.begin(), temp.end() };
+		return std::u8string(ToUtf8Chars(integer).GetView());
 	}
-}
\ No newline at end of file
+}